@@ -0,0 +1,191 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetActions/FastAssetDeletion.h"
+#include "AssetAnalysis/ContentAnalysis.h"
+#include "AssetRegistryModule.h"
+#include "ObjectTools.h"
+#include "ISourceControlModule.h"
+#include "ISourceControlProvider.h"
+#include "Settings/SuperManagerSettings.h"
+#include "Misc/ScopedSlowTask.h"
+#include "Misc/PackageName.h"
+#include "HAL/FileManager.h"
+
+FFastAssetDeletionStats FFastAssetDeletion::DeleteAssets(const TArray<FAssetData>& AssetsDataToDelete)
+{
+	const double DeletionStartTime = FPlatformTime::Seconds();
+
+	FFastAssetDeletionStats Stats;
+
+	TArray<FName> FastPackageNames;
+	TArray<FAssetData> FallbackAssetsData;
+	PartitionAssets(AssetsDataToDelete, FastPackageNames, FallbackAssetsData);
+
+	if (FastPackageNames.Num() > 0)
+	{
+		const int32 ChunkSize = FMath::Max(GetDefault<USuperManagerSettings>()->FastDeletionChunkSize, 1);
+
+		IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+		FScopedSlowTask SlowTask(FastPackageNames.Num(), FText::FromString(TEXT("Deleting unreferenced assets...")));
+		SlowTask.MakeDialogDelayed(1.0f);
+
+		TArray<FString> DeletedFilenames;
+		for (int32 ChunkStartIndex = 0; ChunkStartIndex < FastPackageNames.Num(); ChunkStartIndex += ChunkSize)
+		{
+			const int32 ChunkNum = FMath::Min(ChunkSize, FastPackageNames.Num() - ChunkStartIndex);
+			SlowTask.EnterProgressFrame(ChunkNum);
+
+			DeletedFilenames.Reset();
+			DeletePackageFiles(TArrayView<const FName>(FastPackageNames).Slice(ChunkStartIndex, ChunkNum), DeletedFilenames, Stats);
+
+			// The rescan finds the files gone and removes their assets, one registry update per chunk
+			if (DeletedFilenames.Num() > 0)
+			{
+				AssetRegistry.ScanModifiedAssetFiles(DeletedFilenames);
+			}
+
+			++Stats.NumChunks;
+		}
+	}
+
+	// Everything else keeps the editor's own reference checks and confirmation
+	if (FallbackAssetsData.Num() > 0)
+	{
+		Stats.NumAssetsFallenBack = FallbackAssetsData.Num();
+		Stats.NumAssetsDeleted += ObjectTools::DeleteAssets(FallbackAssetsData);
+	}
+
+	Stats.Seconds = FPlatformTime::Seconds() - DeletionStartTime;
+	return Stats;
+}
+
+void FFastAssetDeletion::PartitionAssets(const TArray<FAssetData>& AssetsDataToDelete, TArray<FName>& OutFastPackageNames, TArray<FAssetData>& OutFallbackAssetsData)
+{
+	// Deleting files behind source control's back would leave them checked in, let the editor mark them for delete
+	ISourceControlModule& SourceControlModule = ISourceControlModule::Get();
+	if (SourceControlModule.IsEnabled() && SourceControlModule.GetProvider().IsAvailable())
+	{
+		OutFallbackAssetsData = AssetsDataToDelete;
+		return;
+	}
+
+	TMap<FName, int32> NumAssetsPerPackage;
+	NumAssetsPerPackage.Reserve(AssetsDataToDelete.Num());
+	for (const FAssetData& AssetData : AssetsDataToDelete)
+	{
+		++NumAssetsPerPackage.FindOrAdd(AssetData.PackageName);
+	}
+
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	TSet<FName> FallbackPackageNames;
+	TArray<FAssetIdentifier> Referencers;
+	TArray<FAssetData> PackageAssetsData;
+
+	for (const TPair<FName, int32>& PackageAssetCount : NumAssetsPerPackage)
+	{
+		const FName PackageName = PackageAssetCount.Key;
+
+		// Loaded packages may be dirty or referenced from memory, only the editor can delete those safely
+		bool bNeedsFallback = FindPackage(nullptr, *PackageName.ToString()) != nullptr;
+
+		// The whole file goes, so every asset in it has to be part of the deletion
+		if (!bNeedsFallback)
+		{
+			PackageAssetsData.Reset();
+			AssetRegistry.GetAssetsByPackageName(PackageName, PackageAssetsData, true);
+			bNeedsFallback = PackageAssetsData.Num() != PackageAssetCount.Value;
+		}
+
+		// References between packages of the same deletion don't keep anything alive.
+		// Every category counts, a primary asset or label managing the package is not a package reference but keeps it cooked
+		if (!bNeedsFallback)
+		{
+			Referencers.Reset();
+			AssetRegistry.GetReferencers(FAssetIdentifier(PackageName), Referencers, UE::AssetRegistry::EDependencyCategory::All);
+			bNeedsFallback = Referencers.ContainsByPredicate([&NumAssetsPerPackage, PackageName](const FAssetIdentifier& Referencer)
+			{
+				if (!Referencer.IsPackage())
+				{
+					return true;
+				}
+
+				return Referencer.PackageName != PackageName && !NumAssetsPerPackage.Contains(Referencer.PackageName);
+			});
+		}
+
+		if (bNeedsFallback)
+		{
+			FallbackPackageNames.Add(PackageName);
+		}
+		else
+		{
+			OutFastPackageNames.Add(PackageName);
+		}
+	}
+
+	for (const FAssetData& AssetData : AssetsDataToDelete)
+	{
+		if (FallbackPackageNames.Contains(AssetData.PackageName))
+		{
+			OutFallbackAssetsData.Add(AssetData);
+		}
+	}
+}
+
+void FFastAssetDeletion::DeletePackageFiles(TArrayView<const FName> PackageNames, TArray<FString>& OutDeletedFilenames, FFastAssetDeletionStats& InOutStats)
+{
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	IFileManager& FileManager = IFileManager::Get();
+
+	TArray<FAssetData> PackageAssetsData;
+
+	for (const FName PackageName : PackageNames)
+	{
+		FString PackageFilename;
+		if (!FPackageName::DoesPackageExist(PackageName.ToString(), &PackageFilename))
+		{
+			continue;
+		}
+
+		PackageAssetsData.Reset();
+		AssetRegistry.GetAssetsByPackageName(PackageName, PackageAssetsData, true);
+
+		const int64 PackageFileSize = FileManager.FileSize(*PackageFilename);
+		if (!FileManager.Delete(*PackageFilename, false, false, true))
+		{
+			InOutStats.FailedPackageNames.Add(PackageName);
+			continue;
+		}
+
+		OutDeletedFilenames.Add(PackageFilename);
+
+		++InOutStats.NumPackagesDeleted;
+		InOutStats.NumAssetsDeleted += PackageAssetsData.Num();
+		InOutStats.NumBytesDeleted += FMath::Max<int64>(PackageFileSize, 0);
+
+		// Packages saved with separate bulk data or exports leave payload files next to them, they go too
+		const FString BaseFilename = FPaths::ChangeExtension(PackageFilename, FString());
+		for (const TCHAR* SidecarExtension : FContentAnalysis::GetPackageSidecarExtensions())
+		{
+			const FString SidecarFilename = BaseFilename + SidecarExtension;
+
+			const int64 SidecarFileSize = FileManager.FileSize(*SidecarFilename);
+			if (SidecarFileSize < 0)
+			{
+				continue;
+			}
+
+			if (FileManager.Delete(*SidecarFilename, false, false, true))
+			{
+				OutDeletedFilenames.Add(SidecarFilename);
+				InOutStats.NumBytesDeleted += SidecarFileSize;
+			}
+			else
+			{
+				InOutStats.FailedPackageNames.AddUnique(PackageName);
+			}
+		}
+	}
+}
@@ -7,6 +7,8 @@
 #include "ObjectTools.h"
 #include "AssetRegistryModule.h"
 #include "AssetToolsModule.h"
+#include "SuperManagerModule.h"
+#include "AssetActions/RedirectorFixup.h"
 
 void UQuickAssetAction::DuplicateAssets(int32 NumOfDuplicates)
 {
@@ -103,12 +105,29 @@ void UQuickAssetAction::RemoveUnusedAssets()
 	TArray<FAssetData> SelectedAssetsData = UEditorUtilityLibrary::GetSelectedAssetData();
 	TArray<FAssetData> UnusedAssetsData;
 
-	FixUpRedirectors();
+	TArray<FName> SelectedPackageNames;
+	for (const FAssetData& SelectedAssetData : SelectedAssetsData)
+	{
+		SelectedPackageNames.Add(SelectedAssetData.PackageName);
+	}
+
+	TArray<FAssetData> RedirectorsData;
+	FRedirectorFixup::FindRedirectorsForPackages(SelectedPackageNames, RedirectorsData);
+
+	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+
+	// Fixed up referencers now point to new packages, otherwise the tracker's index is still current
+	if (FRedirectorFixup::FixUpRedirectors(RedirectorsData).NumRedirectorsFixed > 0)
+	{
+		SuperManagerModule.InvalidateAssetReferenceIndex();
+	}
+
+	// Asks the registry directly until the index has been rebuilt
+	FUnusedAssetsTracker& UnusedAssetsTracker = SuperManagerModule.GetUnusedAssetsTracker();
 
 	for (const FAssetData& SelectedAssetData : SelectedAssetsData)
 	{
-		TArray<FString> AssetReferencers = UEditorAssetLibrary::FindPackageReferencersForAsset(SelectedAssetData.ObjectPath.ToString());
-		if (AssetReferencers.Num() == 0)
+		if (UnusedAssetsTracker.IsPackageUnused(SelectedAssetData.PackageName))
 		{
 			UnusedAssetsData.Add(SelectedAssetData);
 		}
@@ -127,30 +146,3 @@ void UQuickAssetAction::RemoveUnusedAssets()
 		DebugHeader::ShowNotifyInfo(TEXT("Successfully deleted " + FString::FromInt(NumOfAssetsDeleted) + " unused assets"));
 	}
 }
-
-void UQuickAssetAction::FixUpRedirectors()
-{
-	TArray<UObjectRedirector*> RedirectorsToFixArray;
-
-	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
-
-	FARFilter Filter;
-	Filter.bRecursivePaths = true;
-	Filter.PackagePaths.Emplace("/Game");
-	Filter.ClassNames.Emplace("ObjectRedirector");
-
-	TArray<FAssetData> OutRedirectors;
-	
-	AssetRegistryModule.Get().GetAssets(Filter, OutRedirectors);
-
-	for (const FAssetData& RedirectorData : OutRedirectors)
-	{
-		if (UObjectRedirector* RedirectorToFix = Cast<UObjectRedirector>(RedirectorData.GetAsset()))
-		{
-			RedirectorsToFixArray.Add(RedirectorToFix);
-		}
-	}
-
-	FAssetToolsModule& AssetToolsModule = FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools"));
-	AssetToolsModule.Get().FixupReferencers(RedirectorsToFixArray);
-}
@@ -0,0 +1,280 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetActions/RedirectorFixup.h"
+#include "AssetAnalysis/ContentAnalysis.h"
+#include "AssetRegistryModule.h"
+#include "AssetToolsModule.h"
+#include "UObject/ObjectRedirector.h"
+#include "FileHelpers.h"
+#include "PackageTools.h"
+#include "Settings/SuperManagerSettings.h"
+#include "Misc/ScopedSlowTask.h"
+#include "HAL/PlatformMemory.h"
+
+namespace
+{
+	/** Only redirectors under this root are ever fixed, engine and plugin content is read only */
+	const TCHAR* RedirectorsRootPath = TEXT("/Game");
+}
+
+void FRedirectorFixup::FindRedirectorsForFolders(const TArray<FString>& FolderPaths, TArray<FAssetData>& OutRedirectorsData)
+{
+	TArray<FString> FolderPrefixes;
+	FolderPrefixes.Reserve(FolderPaths.Num());
+
+	for (const FString& FolderPath : FolderPaths)
+	{
+		FString FolderPrefix = FolderPath;
+		FolderPrefix.RemoveFromEnd(TEXT("/"));
+		FolderPrefix.AppendChar(TEXT('/'));
+		FolderPrefixes.Add(MoveTemp(FolderPrefix));
+	}
+
+	FindRedirectorsInScope([&FolderPrefixes](FName PackageName)
+	{
+		const FString PackageNameString = PackageName.ToString();
+		for (const FString& FolderPrefix : FolderPrefixes)
+		{
+			if (PackageNameString.StartsWith(FolderPrefix))
+			{
+				return true;
+			}
+		}
+		return false;
+	}, OutRedirectorsData);
+}
+
+void FRedirectorFixup::FindRedirectorsForPackages(const TArray<FName>& PackageNames, TArray<FAssetData>& OutRedirectorsData)
+{
+	const TSet<FName> PackageNamesInScope(PackageNames);
+
+	FindRedirectorsInScope([&PackageNamesInScope](FName PackageName)
+	{
+		return PackageNamesInScope.Contains(PackageName);
+	}, OutRedirectorsData);
+}
+
+void FRedirectorFixup::FindRedirectorsInScope(TFunctionRef<bool(FName PackageName)> IsPackageInScope, TArray<FAssetData>& OutRedirectorsData)
+{
+	// Usually empty, in which case nothing else is queried
+	TArray<FAssetData> AllRedirectorsData;
+	FContentAnalysis::FindRedirectors(RedirectorsRootPath, AllRedirectorsData);
+
+	if (AllRedirectorsData.Num() == 0)
+	{
+		return;
+	}
+
+	// Walked from the redirectors' side, there are far fewer of them than assets in the scope
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	TArray<FName> LinkedPackageNames;
+	for (FAssetData& RedirectorData : AllRedirectorsData)
+	{
+		bool bIsRelevant = IsPackageInScope(RedirectorData.PackageName);
+
+		if (!bIsRelevant)
+		{
+			LinkedPackageNames.Reset();
+			AssetRegistry.GetDependencies(RedirectorData.PackageName, LinkedPackageNames, UE::AssetRegistry::EDependencyCategory::Package);
+			AssetRegistry.GetReferencers(RedirectorData.PackageName, LinkedPackageNames, UE::AssetRegistry::EDependencyCategory::Package);
+
+			for (const FName& LinkedPackageName : LinkedPackageNames)
+			{
+				if (IsPackageInScope(LinkedPackageName))
+				{
+					bIsRelevant = true;
+					break;
+				}
+			}
+		}
+
+		if (bIsRelevant)
+		{
+			OutRedirectorsData.Add(MoveTemp(RedirectorData));
+		}
+	}
+}
+
+FRedirectorFixupStats FRedirectorFixup::FixUpRedirectors(const TArray<FAssetData>& RedirectorsData)
+{
+	FRedirectorFixupStats Stats;
+	if (RedirectorsData.Num() == 0)
+	{
+		return Stats;
+	}
+
+	const double FixupStartTime = FPlatformTime::Seconds();
+
+	const USuperManagerSettings* SuperManagerSettings = GetDefault<USuperManagerSettings>();
+	const int32 MaxBatchSize = FMath::Max(SuperManagerSettings->RedirectorFixupBatchSize, 1);
+	int32 BatchSize = MaxBatchSize;
+
+	// The budget is what a single batch may add on top of what the editor holds after the previous one was unloaded
+	const uint64 MemoryBudget = static_cast<uint64>(FMath::Max(SuperManagerSettings->RedirectorFixupMemoryBudgetMB, 1)) * 1024 * 1024;
+
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	struct FRedirectorToFix
+	{
+		int32 RedirectorDataIndex;
+		TArray<FName> ReferencerPackageNames;
+	};
+
+	TArray<FRedirectorToFix> RedirectorsToFix;
+	RedirectorsToFix.Reserve(RedirectorsData.Num());
+
+	for (int32 RedirectorDataIndex = 0; RedirectorDataIndex < RedirectorsData.Num(); ++RedirectorDataIndex)
+	{
+		FRedirectorToFix& RedirectorToFix = RedirectorsToFix.AddDefaulted_GetRef();
+		RedirectorToFix.RedirectorDataIndex = RedirectorDataIndex;
+
+		AssetRegistry.GetReferencers(RedirectorsData[RedirectorDataIndex].PackageName, RedirectorToFix.ReferencerPackageNames, UE::AssetRegistry::EDependencyCategory::Package);
+		RedirectorToFix.ReferencerPackageNames.Sort(FNameLexicalLess());
+	}
+
+	// One checkout prompt for every referencer the batches will resave, nothing is fixed if the user declines.
+	// The prompt only needs package names, referencers that aren't loaded get an empty package until their batch loads them.
+	TSet<FName> ReferencerPackageNames;
+	for (const FRedirectorToFix& RedirectorToFix : RedirectorsToFix)
+	{
+		ReferencerPackageNames.Append(RedirectorToFix.ReferencerPackageNames);
+	}
+
+	TArray<UPackage*> PackagesToCheckOut;
+	PackagesToCheckOut.Reserve(ReferencerPackageNames.Num());
+
+	for (const FName& ReferencerPackageName : ReferencerPackageNames)
+	{
+		const FString ReferencerPackageNameString = ReferencerPackageName.ToString();
+
+		UPackage* ReferencerPackage = FindPackage(nullptr, *ReferencerPackageNameString);
+		PackagesToCheckOut.Add(ReferencerPackage ? ReferencerPackage : CreatePackage(*ReferencerPackageNameString));
+	}
+
+	if (PackagesToCheckOut.Num() > 0 && FEditorFileUtils::PromptToCheckoutPackages(false, PackagesToCheckOut) == ECommandResult::Cancelled)
+	{
+		return Stats;
+	}
+	PackagesToCheckOut.Empty();
+
+	// Redirectors sharing referencers end up next to each other, so those referencers are loaded once
+	RedirectorsToFix.Sort([](const FRedirectorToFix& A, const FRedirectorToFix& B)
+	{
+		const FName FirstReferencerA = A.ReferencerPackageNames.Num() > 0 ? A.ReferencerPackageNames[0] : NAME_None;
+		const FName FirstReferencerB = B.ReferencerPackageNames.Num() > 0 ? B.ReferencerPackageNames[0] : NAME_None;
+		return FirstReferencerA.LexicalLess(FirstReferencerB);
+	});
+
+	FAssetToolsModule& AssetToolsModule = FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools"));
+
+	FScopedSlowTask SlowTask(RedirectorsToFix.Num(), FText::FromString(TEXT("Fixing up redirectors...")));
+	SlowTask.MakeDialogDelayed(1.0f);
+
+	TSet<FName> BatchPackageNames;
+	TArray<int32> BatchRedirectorDataIndices;
+	TArray<UObjectRedirector*> BatchRedirectors;
+	TArray<FName> BatchLoadedPackageNames;
+	TArray<UPackage*> BatchLoadedPackages;
+
+	uint64 UsedPhysicalBeforeBatch = FPlatformMemory::GetStats().UsedPhysical;
+
+	int32 NextRedirectorToFix = 0;
+	while (NextRedirectorToFix < RedirectorsToFix.Num())
+	{
+		BatchPackageNames.Reset();
+		BatchRedirectorDataIndices.Reset();
+
+		// A redirector is never split from its referencers, a batch holds at least one redirector whatever its size
+		while (NextRedirectorToFix < RedirectorsToFix.Num())
+		{
+			const FRedirectorToFix& RedirectorToFix = RedirectorsToFix[NextRedirectorToFix];
+
+			const int32 NumPackagesToAdd = RedirectorToFix.ReferencerPackageNames.Num() + 1;
+			if (BatchRedirectorDataIndices.Num() > 0 && BatchPackageNames.Num() + NumPackagesToAdd > BatchSize)
+			{
+				break;
+			}
+
+			BatchPackageNames.Add(RedirectorsData[RedirectorToFix.RedirectorDataIndex].PackageName);
+			BatchPackageNames.Append(RedirectorToFix.ReferencerPackageNames);
+			BatchRedirectorDataIndices.Add(RedirectorToFix.RedirectorDataIndex);
+			++NextRedirectorToFix;
+		}
+
+		// All requests are queued before waiting, so their I/O overlaps.
+		// Packages the editor already had loaded are left loaded once the batch is done.
+		BatchLoadedPackageNames.Reset();
+		for (const FName& PackageName : BatchPackageNames)
+		{
+			const FString PackageNameString = PackageName.ToString();
+
+			const UPackage* LoadedPackage = FindPackage(nullptr, *PackageNameString);
+			if (!LoadedPackage || !LoadedPackage->IsFullyLoaded())
+			{
+				BatchLoadedPackageNames.Add(PackageName);
+			}
+
+			LoadPackageAsync(PackageNameString);
+		}
+		FlushAsyncLoading();
+
+		Stats.NumPackagesLoaded += BatchPackageNames.Num();
+
+		BatchRedirectors.Reset();
+		for (const int32 RedirectorDataIndex : BatchRedirectorDataIndices)
+		{
+			if (UObjectRedirector* RedirectorToFix = Cast<UObjectRedirector>(RedirectorsData[RedirectorDataIndex].FastGetAsset(false)))
+			{
+				BatchRedirectors.Add(RedirectorToFix);
+			}
+		}
+
+		// Referencers are already in memory and checked out, the fixup only has to resave them
+		if (BatchRedirectors.Num() > 0)
+		{
+			AssetToolsModule.Get().FixupReferencers(BatchRedirectors, false);
+			Stats.NumRedirectorsFixed += BatchRedirectors.Num();
+		}
+		BatchRedirectors.Reset();
+
+		const uint64 BatchUsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+		Stats.PeakUsedPhysical = FMath::Max(Stats.PeakUsedPhysical, BatchUsedPhysical);
+
+		// Deleted redirectors are already gone, what is left of the batch is unloaded before the next one is loaded
+		BatchLoadedPackages.Reset();
+		for (const FName& PackageName : BatchLoadedPackageNames)
+		{
+			UPackage* BatchLoadedPackage = FindPackage(nullptr, *PackageName.ToString());
+			if (IsValid(BatchLoadedPackage))
+			{
+				BatchLoadedPackages.Add(BatchLoadedPackage);
+			}
+		}
+
+		// Unloading collects garbage itself
+		if (BatchLoadedPackages.Num() == 0 || !UPackageTools::UnloadPackages(BatchLoadedPackages))
+		{
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		}
+		++Stats.NumBatches;
+
+		// Only this batch's own growth counts, memory the editor keeps afterwards isn't charged to the next one
+		const uint64 BatchGrowth = BatchUsedPhysical > UsedPhysicalBeforeBatch ? BatchUsedPhysical - UsedPhysicalBeforeBatch : 0;
+		UsedPhysicalBeforeBatch = FPlatformMemory::GetStats().UsedPhysical;
+
+		if (BatchGrowth > MemoryBudget)
+		{
+			BatchSize = FMath::Max(BatchSize / 2, 1);
+		}
+		else if (BatchGrowth < MemoryBudget / 2)
+		{
+			BatchSize = FMath::Min(BatchSize * 2, MaxBatchSize);
+		}
+
+		SlowTask.EnterProgressFrame(BatchRedirectorDataIndices.Num());
+	}
+
+	Stats.Seconds = FPlatformTime::Seconds() - FixupStartTime;
+	return Stats;
+}
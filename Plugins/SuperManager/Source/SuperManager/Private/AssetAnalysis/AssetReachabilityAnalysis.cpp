@@ -0,0 +1,176 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetAnalysis/AssetReachabilityAnalysis.h"
+#include "AssetAnalysis/AssetReferenceIndex.h"
+#include "Settings/SuperManagerSettings.h"
+#include "Settings/ProjectPackagingSettings.h"
+#include "GameMapsSettings.h"
+#include "Engine/AssetManager.h"
+#include "AssetRegistryModule.h"
+
+namespace
+{
+	FString MakeFolderPrefix(const FString& FolderPath)
+	{
+		// Always cook entries may be stored relative to the content folder
+		FString FolderPrefix = FolderPath.StartsWith(TEXT("/")) ? FolderPath : TEXT("/Game/") + FolderPath;
+
+		if (!FolderPrefix.EndsWith(TEXT("/")))
+		{
+			FolderPrefix.Append(TEXT("/"));
+		}
+
+		return FolderPrefix;
+	}
+
+	FName MakePackageNameFromObjectPath(const FString& ObjectPath)
+	{
+		return ObjectPath.IsEmpty() ? NAME_None : FName(*FPackageName::ObjectPathToPackageName(ObjectPath));
+	}
+
+	/**
+	 * Packages a primary asset manages, e.g. everything a PrimaryAssetLabel with bLabelAssetsInMyDirectory covers
+	 * or the asset manager's directory rules. These Manage edges hang off primary asset ids, not packages,
+	 * so the package graph of the reference index never sees them.
+	 */
+	void GatherManagedPackageNames(TSet<FName>& OutManagedPackageNames)
+	{
+		if (!UAssetManager::IsValid())
+		{
+			return;
+		}
+
+		UAssetManager& AssetManager = UAssetManager::Get();
+		AssetManager.UpdateManagementDatabase();
+
+		IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+		TArray<FPrimaryAssetTypeInfo> PrimaryAssetTypeInfos;
+		AssetManager.GetPrimaryAssetTypeInfoList(PrimaryAssetTypeInfos);
+
+		TArray<FPrimaryAssetId> PrimaryAssetIds;
+		TArray<FAssetIdentifier> ManagedIdentifiers;
+
+		for (const FPrimaryAssetTypeInfo& PrimaryAssetTypeInfo : PrimaryAssetTypeInfos)
+		{
+			PrimaryAssetIds.Reset();
+			AssetManager.GetPrimaryAssetIdList(PrimaryAssetTypeInfo.PrimaryAssetType, PrimaryAssetIds);
+
+			for (const FPrimaryAssetId& PrimaryAssetId : PrimaryAssetIds)
+			{
+				ManagedIdentifiers.Reset();
+				AssetRegistry.GetDependencies(FAssetIdentifier(PrimaryAssetId), ManagedIdentifiers, UE::AssetRegistry::EDependencyCategory::Manage);
+
+				for (const FAssetIdentifier& ManagedIdentifier : ManagedIdentifiers)
+				{
+					if (!ManagedIdentifier.PackageName.IsNone())
+					{
+						OutManagedPackageNames.Add(ManagedIdentifier.PackageName);
+					}
+				}
+			}
+		}
+	}
+}
+
+FAssetReachabilityAnalysis::FAssetReachabilityAnalysis(TSharedRef<FAssetReferenceIndex, ESPMode::ThreadSafe> InReferenceIndex)
+	: ReferenceIndex(InReferenceIndex)
+{
+
+}
+
+void FAssetReachabilityAnalysis::Run()
+{
+	ReachableFlags.Init(false, ReferenceIndex->Num());
+	NumReachable = 0;
+
+	TArray<int32> PackagesToVisit;
+	GatherRootPackages(PackagesToVisit);
+	NumRoots = PackagesToVisit.Num();
+
+	// Mark: every package is pushed at most once, every edge is followed at most once
+	for (const int32 RootIndex : PackagesToVisit)
+	{
+		ReachableFlags[RootIndex] = true;
+	}
+	NumReachable = PackagesToVisit.Num();
+
+	while (PackagesToVisit.Num() > 0)
+	{
+		const int32 PackageIndex = PackagesToVisit.Pop(false);
+
+		for (const int32 DependencyIndex : ReferenceIndex->GetDependencies(PackageIndex))
+		{
+			if (!ReachableFlags[DependencyIndex])
+			{
+				ReachableFlags[DependencyIndex] = true;
+				PackagesToVisit.Add(DependencyIndex);
+				++NumReachable;
+			}
+		}
+	}
+}
+
+bool FAssetReachabilityAnalysis::IsPackageReachable(FName PackageName) const
+{
+	const int32 PackageIndex = ReferenceIndex->FindPackageIndex(PackageName);
+
+	// Packages the index doesn't know about can't be proven dead
+	return PackageIndex == INDEX_NONE || ReachableFlags[PackageIndex];
+}
+
+void FAssetReachabilityAnalysis::GatherRootPackages(TArray<int32>& OutRootIndices) const
+{
+	const USuperManagerSettings* SuperManagerSettings = GetDefault<USuperManagerSettings>();
+
+	TArray<FString> RootFolderPrefixes;
+	for (const FDirectoryPath& AlwaysReachableFolder : SuperManagerSettings->AlwaysReachableFolders)
+	{
+		RootFolderPrefixes.Add(MakeFolderPrefix(AlwaysReachableFolder.Path));
+	}
+
+	if (SuperManagerSettings->bTreatDirectoriesToAlwaysCookAsRoots)
+	{
+		for (const FDirectoryPath& AlwaysCookFolder : GetDefault<UProjectPackagingSettings>()->DirectoriesToAlwaysCook)
+		{
+			RootFolderPrefixes.Add(MakeFolderPrefix(AlwaysCookFolder.Path));
+		}
+	}
+
+	// Default game classes are only referenced from config
+	TSet<FName> RootPackageNames;
+	RootPackageNames.Add(MakePackageNameFromObjectPath(UGameMapsSettings::GetGlobalDefaultGameMode()));
+	RootPackageNames.Add(MakePackageNameFromObjectPath(GetDefault<UGameMapsSettings>()->GameInstanceClass.ToString()));
+
+	// Whatever a primary asset manages is cooked with it, even without a package reference
+	if (SuperManagerSettings->bTreatPrimaryAssetsAsRoots)
+	{
+		GatherManagedPackageNames(RootPackageNames);
+	}
+
+	for (int32 PackageIndex = 0; PackageIndex < ReferenceIndex->Num(); ++PackageIndex)
+	{
+		const EIndexedPackageFlags PackageFlags = ReferenceIndex->GetPackageFlags(PackageIndex);
+
+		bool bIsRoot = EnumHasAnyFlags(PackageFlags, EIndexedPackageFlags::ContainsMap)
+			|| (SuperManagerSettings->bTreatPrimaryAssetsAsRoots && EnumHasAnyFlags(PackageFlags, EIndexedPackageFlags::ContainsPrimaryAsset))
+			|| RootPackageNames.Contains(ReferenceIndex->GetPackageName(PackageIndex));
+
+		if (!bIsRoot)
+		{
+			// SuperManager never deletes outside of /Game, so anything there is kept alive
+			const FString PackageName = ReferenceIndex->GetPackageName(PackageIndex).ToString();
+			bIsRoot = !PackageName.StartsWith(TEXT("/Game/"));
+
+			for (int32 PrefixIndex = 0; !bIsRoot && PrefixIndex < RootFolderPrefixes.Num(); ++PrefixIndex)
+			{
+				bIsRoot = PackageName.StartsWith(RootFolderPrefixes[PrefixIndex]);
+			}
+		}
+
+		if (bIsRoot)
+		{
+			OutRootIndices.Add(PackageIndex);
+		}
+	}
+}
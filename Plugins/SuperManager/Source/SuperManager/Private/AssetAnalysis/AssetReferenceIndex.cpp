@@ -0,0 +1,452 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetAnalysis/AssetReferenceIndex.h"
+#include "AssetRegistryModule.h"
+#include "Serialization/NameAsStringProxyArchive.h"
+#include "Misc/EngineVersion.h"
+
+namespace
+{
+	/** Bump whenever the serialized layout changes, older snapshots are then ignored */
+	constexpr uint32 SnapshotMagic = 0x534D5249;
+	constexpr int32 SnapshotVersion = 2;
+
+	/** Same layout as TArray's operator<<, without needing a mutable array */
+	template <typename ElementType>
+	void WriteArray(FArchive& Ar, const TArray<ElementType>& Array)
+	{
+		int32 NumElements = Array.Num();
+		Ar << NumElements;
+
+		for (ElementType Element : Array)
+		{
+			Ar << Element;
+		}
+	}
+
+	bool IsUnderRootPaths(FName PackageName, const TArray<FString>& RootPaths)
+	{
+		TStringBuilder<FName::StringBufferSize> PackageNameBuilder;
+		PackageName.ToString(PackageNameBuilder);
+
+		for (const FString& RootPath : RootPaths)
+		{
+			if (PackageNameBuilder.ToView().StartsWith(RootPath))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+}
+
+void FAssetReferenceIndex::Build(const FAssetReferenceIndex* Snapshot)
+{
+	Reset();
+
+	// Safe to call from worker threads, the registry guards its own state
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	TArray<FAssetData> AllAssetsData;
+	AssetRegistry.GetAllAssets(AllAssetsData, true);
+
+	// Register every package that owns an asset, these are the sources of the dependency edges
+	PackageIndexMap.Reserve(AllAssetsData.Num());
+	PackageNames.Reserve(AllAssetsData.Num());
+	ReferencerCounts.Reserve(AllAssetsData.Num());
+	PackageFlags.Reserve(AllAssetsData.Num());
+	PackageTimestamps.Reserve(AllAssetsData.Num());
+
+	for (const FAssetData& AssetData : AllAssetsData)
+	{
+		const int32 PackageIndex = FindOrAddPackage(AssetData.PackageName);
+		PackageFlags[PackageIndex] |= GetFlagsForAsset(AssetData);
+	}
+
+	TMap<FName, FDateTime> PackageFileTimestamps;
+	TArray<FString> ProjectRootPaths;
+	GatherProjectPackageFileTimestamps(PackageFileTimestamps, ProjectRootPaths);
+
+	// Single pass over the outgoing edges, each edge adds one referencer to its target
+	TArray<FName> Dependencies;
+	const int32 NumSourcePackages = PackageNames.Num();
+
+	DependencyOffsets.Reserve(NumSourcePackages + 1);
+
+	for (int32 PackageIndex = 0; PackageIndex < NumSourcePackages; ++PackageIndex)
+	{
+		DependencyOffsets.Add(DependencyIndices.Num());
+
+		const FName PackageName = PackageNames[PackageIndex];
+		const FDateTime* PackageFileTimestamp = PackageFileTimestamps.Find(PackageName);
+		PackageTimestamps[PackageIndex] = PackageFileTimestamp ? *PackageFileTimestamp : FDateTime(0);
+
+		Dependencies.Reset();
+
+		// Project packages whose file hasn't changed keep the snapshot's edges, so does engine content, the snapshot is dropped when the engine changes
+		const int32 SnapshotIndex = Snapshot ? Snapshot->FindPackageIndex(PackageName) : INDEX_NONE;
+
+		bool bIsUnchanged = false;
+		if (SnapshotIndex != INDEX_NONE)
+		{
+			bIsUnchanged = PackageFileTimestamp ? Snapshot->PackageTimestamps[SnapshotIndex] == *PackageFileTimestamp : !IsUnderRootPaths(PackageName, ProjectRootPaths);
+		}
+
+		if (bIsUnchanged)
+		{
+			for (const int32 SnapshotDependencyIndex : Snapshot->GetDependencies(SnapshotIndex))
+			{
+				Dependencies.Add(Snapshot->PackageNames[SnapshotDependencyIndex]);
+			}
+		}
+		else
+		{
+			AssetRegistry.GetDependencies(PackageName, Dependencies, UE::AssetRegistry::EDependencyCategory::Package);
+			++NumRevalidatedPackages;
+		}
+
+		for (const FName& Dependency : Dependencies)
+		{
+			const int32 DependencyIndex = FindOrAddPackage(Dependency);
+
+			++ReferencerCounts[DependencyIndex];
+			DependencyIndices.Add(DependencyIndex);
+		}
+	}
+
+	// Packages first seen as dependency targets have no asset data and no outgoing edges
+	DependencyOffsets.Add(DependencyIndices.Num());
+
+	bIsBuilt = true;
+}
+
+void FAssetReferenceIndex::Reset()
+{
+	PackageIndexMap.Empty();
+	PackageNames.Empty();
+	ReferencerCounts.Empty();
+	PackageFlags.Empty();
+	PackageTimestamps.Empty();
+
+	DependencyOffsets.Empty();
+	DependencyIndices.Empty();
+	PatchedDependencies.Empty();
+
+	bIsBuilt = false;
+	NumRevalidatedPackages = 0;
+}
+
+void FAssetReferenceIndex::UpdatePackage(FName PackageName, TArray<int32>& OutAffectedPackageIndices)
+{
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	const int32 PackageIndex = FindOrAddPackage(PackageName);
+	OutAffectedPackageIndices.Add(PackageIndex);
+
+	// Take back the referencers the old edges contributed
+	for (const int32 OldDependencyIndex : GetDependencies(PackageIndex))
+	{
+		--ReferencerCounts[OldDependencyIndex];
+		OutAffectedPackageIndices.Add(OldDependencyIndex);
+	}
+
+	TArray<FAssetData> PackageAssetsData;
+	AssetRegistry.GetAssetsByPackageName(PackageName, PackageAssetsData, true);
+
+	PackageFlags[PackageIndex] = EIndexedPackageFlags::None;
+	for (const FAssetData& AssetData : PackageAssetsData)
+	{
+		PackageFlags[PackageIndex] |= GetFlagsForAsset(AssetData);
+	}
+
+	// A removed package keeps its slot, other packages may still reference it
+	TArray<FName> Dependencies;
+	if (PackageAssetsData.Num() > 0)
+	{
+		AssetRegistry.GetDependencies(PackageName, Dependencies, UE::AssetRegistry::EDependencyCategory::Package);
+	}
+
+	TArray<int32> NewDependencyIndices;
+	NewDependencyIndices.Reserve(Dependencies.Num());
+
+	for (const FName& Dependency : Dependencies)
+	{
+		const int32 DependencyIndex = FindOrAddPackage(Dependency);
+
+		++ReferencerCounts[DependencyIndex];
+		NewDependencyIndices.Add(DependencyIndex);
+		OutAffectedPackageIndices.Add(DependencyIndex);
+	}
+
+	PatchedDependencies.Add(PackageIndex, MoveTemp(NewDependencyIndices));
+
+	// Stamp the edges with the file they were read from, so a snapshot taken later stays valid
+	FString PackageFilename;
+	PackageTimestamps[PackageIndex] = FPackageName::DoesPackageExist(PackageName.ToString(), &PackageFilename) ? IFileManager::Get().GetTimeStamp(*PackageFilename) : FDateTime(0);
+}
+
+bool FAssetReferenceIndex::SaveToFile(const FString& Filename) const
+{
+	if (!bIsBuilt)
+	{
+		return false;
+	}
+
+	if (PatchedDependencies.Num() > 0)
+	{
+		FAssetReferenceIndex CompactedIndex(*this);
+		CompactedIndex.CompactDependencies();
+
+		return CompactedIndex.SaveToFile(Filename);
+	}
+
+	TUniquePtr<FArchive> FileWriter(IFileManager::Get().CreateFileWriter(*Filename));
+	if (!FileWriter)
+	{
+		return false;
+	}
+
+	FNameAsStringProxyArchive Ar(*FileWriter);
+	Save(Ar);
+
+	return FileWriter->Close();
+}
+
+bool FAssetReferenceIndex::LoadFromFile(const FString& Filename)
+{
+	Reset();
+
+	TUniquePtr<FArchive> FileReader(IFileManager::Get().CreateFileReader(*Filename));
+	if (!FileReader)
+	{
+		return false;
+	}
+
+	FNameAsStringProxyArchive Ar(*FileReader);
+
+	// A stale, truncated or damaged cache is thrown away, the next build queries the registry instead
+	if (!Load(Ar))
+	{
+		Reset();
+		return false;
+	}
+
+	PackageIndexMap.Reserve(PackageNames.Num());
+	for (int32 PackageIndex = 0; PackageIndex < PackageNames.Num(); ++PackageIndex)
+	{
+		PackageIndexMap.Add(PackageNames[PackageIndex], PackageIndex);
+	}
+
+	return true;
+}
+
+FString FAssetReferenceIndex::GetSnapshotFilePath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("SuperManager") / TEXT("ReferenceIndex.bin");
+}
+
+void FAssetReferenceIndex::Save(FArchive& Ar) const
+{
+	uint32 Magic = SnapshotMagic;
+	int32 Version = SnapshotVersion;
+	FString EngineVersion = FEngineVersion::Current().ToString();
+	Ar << Magic;
+	Ar << Version;
+	Ar << EngineVersion;
+
+	WriteArray(Ar, PackageNames);
+	WriteArray(Ar, ReferencerCounts);
+	WriteArray(Ar, PackageFlags);
+	WriteArray(Ar, PackageTimestamps);
+	WriteArray(Ar, DependencyOffsets);
+	WriteArray(Ar, DependencyIndices);
+}
+
+bool FAssetReferenceIndex::Load(FArchive& Ar)
+{
+	uint32 Magic = 0;
+	int32 Version = 0;
+	FString EngineVersion;
+	Ar << Magic;
+	Ar << Version;
+
+	if (Ar.IsError() || Magic != SnapshotMagic || Version != SnapshotVersion)
+	{
+		return false;
+	}
+
+	// Engine content isn't revalidated, so a snapshot from another engine build is never reused
+	Ar << EngineVersion;
+	if (Ar.IsError() || EngineVersion != FEngineVersion::Current().ToString())
+	{
+		return false;
+	}
+
+	Ar << PackageNames;
+	Ar << ReferencerCounts;
+	Ar << PackageFlags;
+	Ar << PackageTimestamps;
+	Ar << DependencyOffsets;
+	Ar << DependencyIndices;
+
+	bIsBuilt = !Ar.IsError() && HasValidEdges();
+	return bIsBuilt;
+}
+
+bool FAssetReferenceIndex::HasValidEdges() const
+{
+	const int32 NumPackages = PackageNames.Num();
+	if (ReferencerCounts.Num() != NumPackages || PackageFlags.Num() != NumPackages || PackageTimestamps.Num() != NumPackages)
+	{
+		return false;
+	}
+
+	if (DependencyOffsets.Num() == 0 || DependencyOffsets.Num() > NumPackages + 1 || DependencyOffsets[0] != 0 || DependencyOffsets.Last() != DependencyIndices.Num())
+	{
+		return false;
+	}
+
+	for (int32 OffsetIndex = 1; OffsetIndex < DependencyOffsets.Num(); ++OffsetIndex)
+	{
+		if (DependencyOffsets[OffsetIndex] < DependencyOffsets[OffsetIndex - 1])
+		{
+			return false;
+		}
+	}
+
+	for (const int32 DependencyIndex : DependencyIndices)
+	{
+		if (DependencyIndex < 0 || DependencyIndex >= NumPackages)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void FAssetReferenceIndex::GatherProjectPackageFileTimestamps(TMap<FName, FDateTime>& OutPackageFileTimestamps, TArray<FString>& OutProjectRootPaths)
+{
+	TArray<FString> RootContentPaths;
+	FPackageName::QueryRootContentPaths(RootContentPaths);
+
+	const FString ProjectDirectory = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir());
+
+	for (const FString& RootContentPath : RootContentPaths)
+	{
+		const FString RootDirectory = FPaths::ConvertRelativePathToFull(FPackageName::LongPackageNameToFilename(RootContentPath));
+
+		// /Game and the project's own plugins, the engine and its plugins are left alone
+		if (!RootDirectory.StartsWith(ProjectDirectory))
+		{
+			continue;
+		}
+
+		OutProjectRootPaths.Add(RootContentPath);
+
+		IFileManager::Get().IterateDirectoryStatRecursively(*RootDirectory, [&RootContentPath, &RootDirectory, &OutPackageFileTimestamps](const TCHAR* Filename, const FFileStatData& StatData)
+		{
+			const FStringView FilenameView(Filename);
+			if (StatData.bIsDirectory || !(FilenameView.EndsWith(TEXT(".uasset")) || FilenameView.EndsWith(TEXT(".umap"))))
+			{
+				return true;
+			}
+
+			// Files are walked under their own root, so the package name is the root plus the relative path
+			FString RelativePath(FilenameView.RightChop(RootDirectory.Len()));
+			RelativePath.RemoveFromStart(TEXT("/"));
+
+			const FString PackageName = RootContentPath / FPaths::GetBaseFilename(RelativePath, false);
+			OutPackageFileTimestamps.Add(FName(*PackageName), StatData.ModificationTime);
+
+			return true;
+		});
+	}
+}
+
+int32 FAssetReferenceIndex::GetReferencerCount(FName PackageName) const
+{
+	const int32* PackageIndex = PackageIndexMap.Find(PackageName);
+	return PackageIndex ? ReferencerCounts[*PackageIndex] : 0;
+}
+
+int32 FAssetReferenceIndex::FindPackageIndex(FName PackageName) const
+{
+	const int32* PackageIndex = PackageIndexMap.Find(PackageName);
+	return PackageIndex ? *PackageIndex : INDEX_NONE;
+}
+
+TConstArrayView<int32> FAssetReferenceIndex::GetDependencies(int32 PackageIndex) const
+{
+	if (PatchedDependencies.Num() > 0)
+	{
+		if (const TArray<int32>* PatchedDependencyIndices = PatchedDependencies.Find(PackageIndex))
+		{
+			return *PatchedDependencyIndices;
+		}
+	}
+
+	if (PackageIndex + 1 >= DependencyOffsets.Num())
+	{
+		return TConstArrayView<int32>();
+	}
+
+	const int32 FirstDependency = DependencyOffsets[PackageIndex];
+	return MakeArrayView(DependencyIndices.GetData() + FirstDependency, DependencyOffsets[PackageIndex + 1] - FirstDependency);
+}
+
+int32 FAssetReferenceIndex::FindOrAddPackage(FName PackageName)
+{
+	if (const int32* PackageIndex = PackageIndexMap.Find(PackageName))
+	{
+		return *PackageIndex;
+	}
+
+	const int32 NewPackageIndex = PackageNames.Add(PackageName);
+	ReferencerCounts.Add(0);
+	PackageFlags.Add(EIndexedPackageFlags::None);
+	PackageTimestamps.Add(FDateTime(0));
+	PackageIndexMap.Add(PackageName, NewPackageIndex);
+
+	return NewPackageIndex;
+}
+
+void FAssetReferenceIndex::CompactDependencies()
+{
+	TArray<int32> CompactedOffsets;
+	TArray<int32> CompactedIndices;
+	CompactedOffsets.Reserve(PackageNames.Num() + 1);
+	CompactedIndices.Reserve(DependencyIndices.Num());
+
+	for (int32 PackageIndex = 0; PackageIndex < PackageNames.Num(); ++PackageIndex)
+	{
+		CompactedOffsets.Add(CompactedIndices.Num());
+		CompactedIndices.Append(GetDependencies(PackageIndex));
+	}
+
+	CompactedOffsets.Add(CompactedIndices.Num());
+
+	DependencyOffsets = MoveTemp(CompactedOffsets);
+	DependencyIndices = MoveTemp(CompactedIndices);
+	PatchedDependencies.Empty();
+}
+
+EIndexedPackageFlags FAssetReferenceIndex::GetFlagsForAsset(const FAssetData& AssetData)
+{
+	static const FName WorldClassName(TEXT("World"));
+
+	EIndexedPackageFlags Flags = EIndexedPackageFlags::ContainsAssets;
+
+	if (AssetData.AssetClass == WorldClassName)
+	{
+		Flags |= EIndexedPackageFlags::ContainsMap;
+	}
+
+	if (AssetData.GetPrimaryAssetId().IsValid())
+	{
+		Flags |= EIndexedPackageFlags::ContainsPrimaryAsset;
+	}
+
+	return Flags;
+}
@@ -0,0 +1,371 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetAnalysis/ContentAnalysis.h"
+#include "AssetAnalysis/AssetReferenceIndex.h"
+#include "AssetAnalysis/AssetReachabilityAnalysis.h"
+#include "AssetAnalysis/PathExclusionRules.h"
+#include "AssetRegistryModule.h"
+#include "Async/ParallelFor.h"
+#include "Misc/PackageName.h"
+#include "HAL/FileManager.h"
+
+namespace
+{
+	/** Packages per worker task, large enough to amortize scheduling, small enough to balance uneven lookups */
+	constexpr int32 ReferencerQueryChunkSize = 64;
+
+	const TCHAR* PackageSidecarExtensions[] =
+	{
+		TEXT(".uexp"),
+		TEXT(".ubulk"),
+		TEXT(".uptnl"),
+		TEXT(".m.ubulk")
+	};
+}
+
+void FContentAnalysis::CollapseNestedFolders(const TArray<FString>& FolderPaths, TArray<FString>& OutRootFolderPaths)
+{
+	const FPathExclusionRules& ExclusionRules = FPathExclusionRules::Get();
+
+	TSet<FString> SelectedFolderPaths;
+	SelectedFolderPaths.Reserve(FolderPaths.Num());
+	for (FString FolderPath : FolderPaths)
+	{
+		FolderPath.RemoveFromEnd(TEXT("/"));
+		if (!FolderPath.IsEmpty() && !ExclusionRules.IsFolderExcluded(FolderPath))
+		{
+			SelectedFolderPaths.Add(MoveTemp(FolderPath));
+		}
+	}
+
+	// A folder is a root unless one of its ancestors is selected too, a parent walk sidesteps sort order pitfalls like /A-B sorting between /A and /A/B
+	for (const FString& FolderPath : SelectedFolderPaths)
+	{
+		bool bHasSelectedAncestor = false;
+
+		int32 LastSlashIndex = INDEX_NONE;
+		FString AncestorPath = FolderPath;
+		while (!bHasSelectedAncestor && AncestorPath.FindLastChar(TEXT('/'), LastSlashIndex) && LastSlashIndex > 0)
+		{
+			AncestorPath.LeftInline(LastSlashIndex, false);
+			bHasSelectedAncestor = SelectedFolderPaths.Contains(AncestorPath);
+		}
+
+		if (!bHasSelectedAncestor)
+		{
+			OutRootFolderPaths.Add(FolderPath);
+		}
+	}
+}
+
+void FContentAnalysis::GatherFoldersUnderFolder(const FString& FolderPath, TArray<FName>& OutFolderPaths)
+{
+	const FPathExclusionRules& ExclusionRules = FPathExclusionRules::Get();
+	if (ExclusionRules.IsFolderExcluded(FolderPath))
+	{
+		return;
+	}
+
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	// Excluded folders are never expanded, so nothing under them is enumerated
+	TArray<FString> FoldersToVisit;
+	FoldersToVisit.Add(FolderPath);
+
+	TArray<FString> SubPaths;
+	while (FoldersToVisit.Num() > 0)
+	{
+		const FString CurrentFolderPath = FoldersToVisit.Pop(false);
+		OutFolderPaths.Add(FName(*CurrentFolderPath));
+
+		SubPaths.Reset();
+		AssetRegistry.GetSubPaths(CurrentFolderPath, SubPaths, false);
+
+		for (FString& SubPath : SubPaths)
+		{
+			if (!ExclusionRules.IsFolderExcluded(SubPath))
+			{
+				FoldersToVisit.Add(MoveTemp(SubPath));
+			}
+		}
+	}
+}
+
+void FContentAnalysis::GatherAssetsUnderFolder(const FString& FolderPath, TArray<FAssetData>& OutAssetsData)
+{
+	TArray<FString> FolderPaths;
+	FolderPaths.Add(FolderPath);
+	GatherAssetsUnderFolders(FolderPaths, OutAssetsData);
+}
+
+void FContentAnalysis::GatherAssetsUnderFolders(const TArray<FString>& FolderPaths, TArray<FAssetData>& OutAssetsData)
+{
+	TArray<FString> RootFolderPaths;
+	CollapseNestedFolders(FolderPaths, RootFolderPaths);
+
+	// Roots are disjoint, so every kept folder is listed once and no asset can be gathered twice
+	FARFilter Filter;
+	for (const FString& RootFolderPath : RootFolderPaths)
+	{
+		GatherFoldersUnderFolder(RootFolderPath, Filter.PackagePaths);
+	}
+
+	if (Filter.PackagePaths.Num() == 0)
+	{
+		return;
+	}
+
+	// Excluded subtrees are pruned while the path list is built, a single non recursive query then covers every kept folder
+	IAssetRegistry::GetChecked().GetAssets(Filter, OutAssetsData);
+}
+
+void FContentAnalysis::FindUnusedAssets(const TArray<FAssetData>& AssetsDataToFilter, const FAssetReferenceIndex& ReferenceIndex, TArray<FAssetData>& OutUnusedAssetsData)
+{
+	for (const FAssetData& AssetData : AssetsDataToFilter)
+	{
+		if (ReferenceIndex.IsPackageUnused(AssetData.PackageName))
+		{
+			OutUnusedAssetsData.Add(AssetData);
+		}
+	}
+}
+
+void FContentAnalysis::FindUnreachableAssets(const TArray<FAssetData>& AssetsDataToFilter, const FAssetReachabilityAnalysis& ReachabilityAnalysis, TArray<FAssetData>& OutUnreachableAssetsData)
+{
+	for (const FAssetData& AssetData : AssetsDataToFilter)
+	{
+		if (!ReachabilityAnalysis.IsPackageReachable(AssetData.PackageName))
+		{
+			OutUnreachableAssetsData.Add(AssetData);
+		}
+	}
+}
+
+void FContentAnalysis::FindSameNameAssets(const TArray<FAssetData>& AssetsDataToFilter, TArray<FAssetData>& OutSameNameAssetsData)
+{
+	TMap<FName, int32> AssetNameCounts;
+	AssetNameCounts.Reserve(AssetsDataToFilter.Num());
+
+	for (const FAssetData& AssetData : AssetsDataToFilter)
+	{
+		++AssetNameCounts.FindOrAdd(AssetData.AssetName);
+	}
+
+	for (const FAssetData& AssetData : AssetsDataToFilter)
+	{
+		if (AssetNameCounts.FindChecked(AssetData.AssetName) > 1)
+		{
+			OutSameNameAssetsData.Add(AssetData);
+		}
+	}
+}
+
+void FContentAnalysis::QueryUnusedPackages(TConstArrayView<FName> PackageNames, TArray<bool>& OutIsUnused)
+{
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	OutIsUnused.SetNumUninitialized(PackageNames.Num());
+
+	TArray<FName> Referencers;
+	for (int32 PackageIndex = 0; PackageIndex < PackageNames.Num(); ++PackageIndex)
+	{
+		Referencers.Reset();
+		AssetRegistry.GetReferencers(PackageNames[PackageIndex], Referencers, UE::AssetRegistry::EDependencyCategory::Package);
+
+		OutIsUnused[PackageIndex] = Referencers.Num() == 0;
+	}
+}
+
+void FContentAnalysis::QueryUnusedPackagesInParallel(TConstArrayView<FName> PackageNames, TArray<bool>& OutIsUnused)
+{
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	OutIsUnused.SetNumUninitialized(PackageNames.Num());
+
+	// Referencer queries only take the registry's read lock, so workers query it directly and write disjoint result slots
+	const int32 NumChunks = FMath::DivideAndRoundUp(PackageNames.Num(), ReferencerQueryChunkSize);
+	ParallelFor(NumChunks, [&AssetRegistry, &PackageNames, &OutIsUnused](int32 ChunkIndex)
+	{
+		const int32 ChunkStart = ChunkIndex * ReferencerQueryChunkSize;
+		const int32 ChunkEnd = FMath::Min(ChunkStart + ReferencerQueryChunkSize, PackageNames.Num());
+
+		TArray<FName> Referencers;
+		for (int32 PackageIndex = ChunkStart; PackageIndex < ChunkEnd; ++PackageIndex)
+		{
+			Referencers.Reset();
+			AssetRegistry.GetReferencers(PackageNames[PackageIndex], Referencers, UE::AssetRegistry::EDependencyCategory::Package);
+
+			OutIsUnused[PackageIndex] = Referencers.Num() == 0;
+		}
+	});
+}
+
+void FContentAnalysis::FindEmptyFolders(const TArray<FString>& FolderPathsToSearch, TArray<FString>& OutEmptyFolderPaths)
+{
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	const FPathExclusionRules& ExclusionRules = FPathExclusionRules::Get();
+
+	// Selected folders are walked like their subfolders, overlapping selections are only visited once.
+	// Excluded folders are never expanded, only their parent is remembered, deleting it would take them along.
+	TSet<FString> UniqueFolderPaths;
+	TSet<FString> FolderPathsToKeep;
+
+	TArray<FString> FoldersToVisit = FolderPathsToSearch;
+	TArray<FString> SubPaths;
+	while (FoldersToVisit.Num() > 0)
+	{
+		const FString CurrentFolderPath = FoldersToVisit.Pop(false);
+
+		if (ExclusionRules.IsFolderExcluded(CurrentFolderPath))
+		{
+			continue;
+		}
+
+		bool bIsAlreadyVisited = false;
+		UniqueFolderPaths.Add(CurrentFolderPath, &bIsAlreadyVisited);
+		if (bIsAlreadyVisited)
+		{
+			continue;
+		}
+
+		SubPaths.Reset();
+		AssetRegistry.GetSubPaths(CurrentFolderPath, SubPaths, false);
+
+		for (FString& SubPath : SubPaths)
+		{
+			if (ExclusionRules.IsFolderExcluded(SubPath))
+			{
+				FolderPathsToKeep.Add(CurrentFolderPath);
+			}
+			else
+			{
+				FoldersToVisit.Add(MoveTemp(SubPath));
+			}
+		}
+	}
+
+	// A parent sorts before all of its descendants, so walking backwards visits children first
+	TArray<FString> FolderPaths = UniqueFolderPaths.Array();
+	FolderPaths.Sort();
+
+	TMap<FName, int32> FolderIndices;
+	FolderIndices.Reserve(FolderPaths.Num());
+
+	TBitArray<> IsFolderEmpty(true, FolderPaths.Num());
+
+	// Only the walked folders are queried, nothing under an excluded folder is enumerated
+	FARFilter Filter;
+	Filter.PackagePaths.Reserve(FolderPaths.Num());
+
+	for (int32 FolderIndex = 0; FolderIndex < FolderPaths.Num(); ++FolderIndex)
+	{
+		const FName FolderName(*FolderPaths[FolderIndex]);
+		FolderIndices.Add(FolderName, FolderIndex);
+		Filter.PackagePaths.Add(FolderName);
+
+		if (FolderPathsToKeep.Contains(FolderPaths[FolderIndex]))
+		{
+			IsFolderEmpty[FolderIndex] = false;
+		}
+	}
+
+	if (Filter.PackagePaths.Num() == 0)
+	{
+		return;
+	}
+
+	// Only the folders that hold assets directly are marked here, the traversal carries it up to their parents
+	AssetRegistry.EnumerateAssets(Filter, [&FolderIndices, &IsFolderEmpty](const FAssetData& AssetData)
+	{
+		if (const int32* FolderIndex = FolderIndices.Find(AssetData.PackagePath))
+		{
+			IsFolderEmpty[*FolderIndex] = false;
+		}
+		return true;
+	});
+
+	for (int32 FolderIndex = FolderPaths.Num() - 1; FolderIndex >= 0; --FolderIndex)
+	{
+		const FString& FolderPath = FolderPaths[FolderIndex];
+
+		// Mount roots such as /Game are never reported
+		int32 LastSlashIndex = INDEX_NONE;
+		const bool bIsMountRoot = !FolderPath.FindLastChar(TEXT('/'), LastSlashIndex) || LastSlashIndex == 0;
+		if (bIsMountRoot)
+		{
+			IsFolderEmpty[FolderIndex] = false;
+		}
+
+		if (IsFolderEmpty[FolderIndex])
+		{
+			OutEmptyFolderPaths.Add(FolderPath);
+			continue;
+		}
+
+		if (!bIsMountRoot)
+		{
+			if (const int32* ParentFolderIndex = FolderIndices.Find(FName(LastSlashIndex, *FolderPath, FNAME_Find)))
+			{
+				IsFolderEmpty[*ParentFolderIndex] = false;
+			}
+		}
+	}
+}
+
+void FContentAnalysis::DeleteEmptyFolders(const TArray<FString>& EmptyFolderPaths, TArray<FString>& OutDeletedFolderPaths)
+{
+	// Same ordering trick as FindEmptyFolders, children come before their parents
+	TArray<FString> FolderPathsToDelete = EmptyFolderPaths;
+	FolderPathsToDelete.Sort([](const FString& A, const FString& B) { return B < A; });
+
+	IFileManager& FileManager = IFileManager::Get();
+
+	TSet<FString> DeletedFolderPaths;
+	DeletedFolderPaths.Reserve(FolderPathsToDelete.Num());
+
+	for (const FString& FolderPath : FolderPathsToDelete)
+	{
+		FString FolderFilename;
+		if (!FPackageName::TryConvertLongPackageNameToFilename(FolderPath, FolderFilename))
+		{
+			continue;
+		}
+
+		// Not a tree delete, a folder that still holds any file on disk is left alone
+		if (FileManager.DeleteDirectory(*FolderFilename, false, false))
+		{
+			DeletedFolderPaths.Add(FolderPath);
+			OutDeletedFolderPaths.Add(FolderPath);
+		}
+	}
+
+	// Removing a path removes its subpaths too, one call per deleted subtree is enough
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	for (const FString& FolderPath : DeletedFolderPaths)
+	{
+		int32 LastSlashIndex = INDEX_NONE;
+		if (FolderPath.FindLastChar(TEXT('/'), LastSlashIndex) && DeletedFolderPaths.Contains(FolderPath.Left(LastSlashIndex)))
+		{
+			continue;
+		}
+
+		AssetRegistry.RemovePath(FolderPath);
+	}
+}
+
+void FContentAnalysis::FindRedirectors(const FString& FolderPath, TArray<FAssetData>& OutRedirectorsData)
+{
+	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
+
+	FARFilter Filter;
+	Filter.bRecursivePaths = true;
+	Filter.PackagePaths.Emplace(*FolderPath);
+	Filter.ClassNames.Emplace("ObjectRedirector");
+
+	AssetRegistryModule.Get().GetAssets(Filter, OutRedirectorsData);
+}
+
+TConstArrayView<const TCHAR*> FContentAnalysis::GetPackageSidecarExtensions()
+{
+	return PackageSidecarExtensions;
+}
@@ -0,0 +1,255 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetAnalysis/DeletionPlan.h"
+#include "AssetAnalysis/ContentAnalysis.h"
+#include "AssetAnalysis/PathExclusionRules.h"
+#include "AssetActions/RedirectorFixup.h"
+#include "Settings/SuperManagerSettings.h"
+#include "AssetRegistryModule.h"
+#include "AssetRegistryState.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "HAL/FileManager.h"
+
+namespace
+{
+	/** Adds Delta to FolderPath and every folder above it, mount roots such as /Game are left out */
+	void AddToFolderAndParents(const FString& FolderPath, int32 Delta, TMap<FString, int32>& InOutCounts)
+	{
+		FString CurrentFolderPath = FolderPath;
+
+		int32 LastSlashIndex = INDEX_NONE;
+		while (CurrentFolderPath.FindLastChar(TEXT('/'), LastSlashIndex) && LastSlashIndex > 0)
+		{
+			InOutCounts.FindOrAdd(CurrentFolderPath) += Delta;
+			CurrentFolderPath.LeftInline(LastSlashIndex, false);
+		}
+	}
+}
+
+void FDeletionPlan::Build(const TArray<FAssetData>& AssetsDataToDelete)
+{
+	AssetObjectPaths.Reset();
+	Packages.Reset();
+	FoldersBecomingEmpty.Reset();
+	RedirectorObjectPaths.Reset();
+	DiskBytes = 0;
+	CookedBytes = INDEX_NONE;
+	CookedRegistryPath.Reset();
+	PlannedAt = FDateTime::Now();
+
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	TSet<FName> PlannedPackageNames;
+	PlannedPackageNames.Reserve(AssetsDataToDelete.Num());
+
+	for (const FAssetData& AssetData : AssetsDataToDelete)
+	{
+		AssetObjectPaths.Add(AssetData.ObjectPath.ToString());
+
+		bool bIsAlreadyPlanned = false;
+		PlannedPackageNames.Add(AssetData.PackageName, &bIsAlreadyPlanned);
+		if (bIsAlreadyPlanned)
+		{
+			continue;
+		}
+
+		FPlannedPackage& PlannedPackage = Packages.AddDefaulted_GetRef();
+		PlannedPackage.PackageName = AssetData.PackageName;
+
+		// The files on disk are the truth, the registry only knows the size from the last scan
+		FString PackageFilename;
+		if (FPackageName::DoesPackageExist(AssetData.PackageName.ToString(), &PackageFilename))
+		{
+			IFileManager& FileManager = IFileManager::Get();
+			PlannedPackage.DiskBytes = FMath::Max<int64>(FileManager.FileSize(*PackageFilename), 0);
+
+			// Payload files are deleted along with the package
+			const FString BaseFilename = FPaths::ChangeExtension(PackageFilename, FString());
+			for (const TCHAR* SidecarExtension : FContentAnalysis::GetPackageSidecarExtensions())
+			{
+				PlannedPackage.DiskBytes += FMath::Max<int64>(FileManager.FileSize(*(BaseFilename + SidecarExtension)), 0);
+			}
+		}
+		else if (TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(AssetData.PackageName))
+		{
+			PlannedPackage.DiskBytes = PackageData->DiskSize;
+		}
+
+		DiskBytes += PlannedPackage.DiskBytes;
+	}
+
+	GatherFoldersBecomingEmpty();
+	GatherCookedSizes();
+
+	TArray<FAssetData> RedirectorsData;
+	FRedirectorFixup::FindRedirectorsForPackages(PlannedPackageNames.Array(), RedirectorsData);
+
+	for (const FAssetData& RedirectorData : RedirectorsData)
+	{
+		RedirectorObjectPaths.Add(RedirectorData.ObjectPath.ToString());
+	}
+}
+
+void FDeletionPlan::GatherFoldersBecomingEmpty()
+{
+	// Planned packages in every folder, subfolders included
+	TMap<FString, int32> NumPlannedPackagesPerFolder;
+	for (const FPlannedPackage& PlannedPackage : Packages)
+	{
+		AddToFolderAndParents(FPackageName::GetLongPackagePath(PlannedPackage.PackageName.ToString()), 1, NumPlannedPackagesPerFolder);
+	}
+
+	if (NumPlannedPackagesPerFolder.Num() == 0)
+	{
+		return;
+	}
+
+	// Every package under the topmost touched folders, counted against the same folders only
+	FARFilter Filter;
+	Filter.bRecursivePaths = true;
+	for (const TPair<FString, int32>& FolderCount : NumPlannedPackagesPerFolder)
+	{
+		int32 LastSlashIndex = INDEX_NONE;
+		if (FolderCount.Key.FindLastChar(TEXT('/'), LastSlashIndex) && !NumPlannedPackagesPerFolder.Contains(FolderCount.Key.Left(LastSlashIndex)))
+		{
+			Filter.PackagePaths.Emplace(*FolderCount.Key);
+		}
+	}
+
+	TMap<FString, int32> NumPackagesPerFolder;
+	TSet<FName> CountedPackageNames;
+
+	IAssetRegistry::GetChecked().EnumerateAssets(Filter, [&NumPackagesPerFolder, &CountedPackageNames](const FAssetData& AssetData)
+	{
+		bool bIsAlreadyCounted = false;
+		CountedPackageNames.Add(AssetData.PackageName, &bIsAlreadyCounted);
+		if (!bIsAlreadyCounted)
+		{
+			AddToFolderAndParents(AssetData.PackagePath.ToString(), 1, NumPackagesPerFolder);
+		}
+		return true;
+	});
+
+	const FPathExclusionRules& ExclusionRules = FPathExclusionRules::Get();
+
+	for (const TPair<FString, int32>& FolderCount : NumPlannedPackagesPerFolder)
+	{
+		const int32* NumPackages = NumPackagesPerFolder.Find(FolderCount.Key);
+		if (NumPackages && *NumPackages == FolderCount.Value && !ExclusionRules.IsFolderExcluded(FolderCount.Key))
+		{
+			FoldersBecomingEmpty.Add(FolderCount.Key);
+		}
+	}
+
+	// A parent sorts before its descendants, so the reverse order lists subfolders first
+	FoldersBecomingEmpty.Sort([](const FString& A, const FString& B) { return B < A; });
+}
+
+void FDeletionPlan::GatherCookedSizes()
+{
+	const USuperManagerSettings* SuperManagerSettings = GetDefault<USuperManagerSettings>();
+	if (SuperManagerSettings->CookedAssetRegistryFile.FilePath.IsEmpty())
+	{
+		return;
+	}
+
+	CookedRegistryPath = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir(), SuperManagerSettings->CookedAssetRegistryFile.FilePath);
+
+	FAssetRegistryLoadOptions LoadOptions;
+	LoadOptions.bLoadDependencies = false;
+	LoadOptions.bLoadPackageData = true;
+
+	FAssetRegistryState CookedRegistryState;
+	if (!FAssetRegistryState::LoadFromDisk(*CookedRegistryPath, LoadOptions, CookedRegistryState))
+	{
+		CookedRegistryPath.Reset();
+		return;
+	}
+
+	// Packages that never got cooked reclaim nothing from the cook
+	CookedBytes = 0;
+	for (FPlannedPackage& PlannedPackage : Packages)
+	{
+		if (const FAssetPackageData* CookedPackageData = CookedRegistryState.GetAssetPackageData(PlannedPackage.PackageName))
+		{
+			PlannedPackage.CookedBytes = CookedPackageData->DiskSize;
+			CookedBytes += CookedPackageData->DiskSize;
+		}
+	}
+}
+
+TSharedRef<FJsonObject> FDeletionPlan::ToJson() const
+{
+	TSharedRef<FJsonObject> PlanObject = MakeShared<FJsonObject>();
+	PlanObject->SetStringField(TEXT("timestamp"), PlannedAt.ToIso8601());
+	PlanObject->SetNumberField(TEXT("diskBytes"), static_cast<double>(DiskBytes));
+	PlanObject->SetNumberField(TEXT("cookedBytes"), static_cast<double>(CookedBytes));
+	PlanObject->SetStringField(TEXT("cookedRegistry"), CookedRegistryPath);
+
+	TArray<TSharedPtr<FJsonValue>> AssetValues;
+	AssetValues.Reserve(AssetObjectPaths.Num());
+	for (const FString& AssetObjectPath : AssetObjectPaths)
+	{
+		AssetValues.Add(MakeShared<FJsonValueString>(AssetObjectPath));
+	}
+	PlanObject->SetArrayField(TEXT("assets"), AssetValues);
+
+	TArray<TSharedPtr<FJsonValue>> PackageValues;
+	PackageValues.Reserve(Packages.Num());
+	for (const FPlannedPackage& PlannedPackage : Packages)
+	{
+		TSharedRef<FJsonObject> PackageObject = MakeShared<FJsonObject>();
+		PackageObject->SetStringField(TEXT("name"), PlannedPackage.PackageName.ToString());
+		PackageObject->SetNumberField(TEXT("diskBytes"), static_cast<double>(PlannedPackage.DiskBytes));
+		PackageObject->SetNumberField(TEXT("cookedBytes"), static_cast<double>(PlannedPackage.CookedBytes));
+		PackageValues.Add(MakeShared<FJsonValueObject>(PackageObject));
+	}
+	PlanObject->SetArrayField(TEXT("packages"), PackageValues);
+
+	TArray<TSharedPtr<FJsonValue>> FolderValues;
+	FolderValues.Reserve(FoldersBecomingEmpty.Num());
+	for (const FString& FolderPath : FoldersBecomingEmpty)
+	{
+		FolderValues.Add(MakeShared<FJsonValueString>(FolderPath));
+	}
+	PlanObject->SetArrayField(TEXT("foldersBecomingEmpty"), FolderValues);
+
+	TArray<TSharedPtr<FJsonValue>> RedirectorValues;
+	RedirectorValues.Reserve(RedirectorObjectPaths.Num());
+	for (const FString& RedirectorObjectPath : RedirectorObjectPaths)
+	{
+		RedirectorValues.Add(MakeShared<FJsonValueString>(RedirectorObjectPath));
+	}
+	PlanObject->SetArrayField(TEXT("redirectors"), RedirectorValues);
+
+	return PlanObject;
+}
+
+bool FDeletionPlan::SaveToFile(const FString& Filename) const
+{
+	FString PlanString;
+	TSharedRef<TJsonWriter<>> PlanWriter = TJsonWriterFactory<>::Create(&PlanString);
+
+	return FJsonSerializer::Serialize(ToJson(), PlanWriter) && FFileHelper::SaveStringToFile(PlanString, *Filename);
+}
+
+FString FDeletionPlan::MakeDefaultFilePath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("SuperManager") / FString::Printf(TEXT("DeletionPlan_%s.json"), *FDateTime::Now().ToString());
+}
+
+FString FDeletionPlan::GetSummary() const
+{
+	FString Summary = FString::Printf(TEXT("%d assets in %d packages, %s on disk"), AssetObjectPaths.Num(), Packages.Num(), *FText::AsMemory(DiskBytes).ToString());
+
+	if (HasCookedSizes())
+	{
+		Summary += FString::Printf(TEXT(", %s cooked"), *FText::AsMemory(CookedBytes).ToString());
+	}
+
+	Summary += FString::Printf(TEXT("\n%d folders would become empty, %d redirectors involved"), FoldersBecomingEmpty.Num(), RedirectorObjectPaths.Num());
+	return Summary;
+}
@@ -0,0 +1,174 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetAnalysis/ExternalPackageAnalysis.h"
+#include "AssetRegistryModule.h"
+#include "Engine/World.h"
+#include "Misc/PackageName.h"
+
+namespace
+{
+	const TCHAR* ExternalActorsFolderName = TEXT("__ExternalActors__");
+	const TCHAR* ExternalObjectsFolderName = TEXT("__ExternalObjects__");
+
+	/** Closest folder at or above FolderPath that belongs to a level, nested levels win over their parents */
+	FName FindFolderLevel(const FString& FolderPath, const TMap<FString, FName>& ExternalFolderLevels)
+	{
+		FString CurrentFolderPath = FolderPath;
+
+		while (true)
+		{
+			if (const FName* LevelPackageName = ExternalFolderLevels.Find(CurrentFolderPath))
+			{
+				return *LevelPackageName;
+			}
+
+			int32 LastSlashIndex = INDEX_NONE;
+			if (!CurrentFolderPath.FindLastChar(TEXT('/'), LastSlashIndex) || LastSlashIndex == 0)
+			{
+				return NAME_None;
+			}
+
+			CurrentFolderPath.LeftInline(LastSlashIndex, false);
+		}
+	}
+}
+
+bool FExternalPackageAnalysis::Run()
+{
+	OrphanedPackages.Reset();
+	NumLevels = 0;
+	NumExternalPackages = 0;
+
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	if (AssetRegistry.IsLoadingAssets())
+	{
+		return false;
+	}
+
+	TArray<FString> RootPaths;
+	FPackageName::QueryRootContentPaths(RootPaths, false, false, true);
+
+	// Every level of every mount point, with the folders its external packages live in
+	TMap<FString, FName> ExternalFolderLevels;
+	{
+		FARFilter Filter;
+		Filter.bRecursivePaths = true;
+		Filter.ClassNames.Add(UWorld::StaticClass()->GetFName());
+		for (const FString& RootPath : RootPaths)
+		{
+			Filter.PackagePaths.Emplace(*RootPath);
+		}
+
+		TArray<FAssetData> LevelsData;
+		AssetRegistry.GetAssets(Filter, LevelsData);
+
+		NumLevels = LevelsData.Num();
+		ExternalFolderLevels.Reserve(LevelsData.Num() * 2);
+
+		for (const FAssetData& LevelData : LevelsData)
+		{
+			const FString LevelPackageName = LevelData.PackageName.ToString();
+			ExternalFolderLevels.Add(MakeExternalFolderPath(LevelPackageName, ExternalActorsFolderName), LevelData.PackageName);
+			ExternalFolderLevels.Add(MakeExternalFolderPath(LevelPackageName, ExternalObjectsFolderName), LevelData.PackageName);
+		}
+	}
+
+	// Every external package of every mount point
+	TArray<FAssetData> ExternalAssetsData;
+	{
+		FARFilter Filter;
+		Filter.bRecursivePaths = true;
+		for (const FString& RootPath : RootPaths)
+		{
+			Filter.PackagePaths.Emplace(*(RootPath / ExternalActorsFolderName));
+			Filter.PackagePaths.Emplace(*(RootPath / ExternalObjectsFolderName));
+		}
+
+		AssetRegistry.GetAssets(Filter, ExternalAssetsData);
+	}
+
+	TSet<FName> ExternalPackageNames;
+	ExternalPackageNames.Reserve(ExternalAssetsData.Num());
+
+	for (const FAssetData& ExternalAssetData : ExternalAssetsData)
+	{
+		ExternalPackageNames.Add(ExternalAssetData.PackageName);
+
+		const FName FolderLevelPackageName = FindFolderLevel(ExternalAssetData.PackagePath.ToString(), ExternalFolderLevels);
+
+		// External actors and objects are saved under their level, the outer path names it
+		const FName OuterPackageName(*FPackageName::ObjectPathToPackageName(ExternalAssetData.ObjectPath.ToString()));
+
+		TOptional<EExternalPackageIssue> Issue;
+		if (FolderLevelPackageName.IsNone())
+		{
+			Issue = EExternalPackageIssue::MissingLevel;
+		}
+		else if (OuterPackageName == ExternalAssetData.PackageName)
+		{
+			Issue = EExternalPackageIssue::NotLevelObject;
+		}
+		else if (OuterPackageName != FolderLevelPackageName)
+		{
+			Issue = EExternalPackageIssue::LevelMismatch;
+		}
+
+		if (Issue.IsSet())
+		{
+			FOrphanedExternalPackage& OrphanedPackage = OrphanedPackages.AddDefaulted_GetRef();
+			OrphanedPackage.AssetData = ExternalAssetData;
+			OrphanedPackage.FolderLevelPackageName = FolderLevelPackageName;
+			OrphanedPackage.Issue = Issue.GetValue();
+		}
+	}
+
+	NumExternalPackages = ExternalPackageNames.Num();
+	return true;
+}
+
+void FExternalPackageAnalysis::GetOrphanedAssetsData(TArray<FAssetData>& OutAssetsData) const
+{
+	OutAssetsData.Reserve(OutAssetsData.Num() + OrphanedPackages.Num());
+
+	for (const FOrphanedExternalPackage& OrphanedPackage : OrphanedPackages)
+	{
+		// The registry may have missed a level, e.g. one synced since it was scanned, its outer path names the package to look for
+		if (OrphanedPackage.Issue == EExternalPackageIssue::MissingLevel)
+		{
+			const FString OuterPackageName = FPackageName::ObjectPathToPackageName(OrphanedPackage.AssetData.ObjectPath.ToString());
+			if (OuterPackageName != OrphanedPackage.AssetData.PackageName.ToString() && FPackageName::DoesPackageExist(OuterPackageName))
+			{
+				continue;
+			}
+		}
+
+		OutAssetsData.Add(OrphanedPackage.AssetData);
+	}
+}
+
+const TCHAR* FExternalPackageAnalysis::LexToString(EExternalPackageIssue Issue)
+{
+	switch (Issue)
+	{
+	case EExternalPackageIssue::MissingLevel:
+		return TEXT("missingLevel");
+	case EExternalPackageIssue::LevelMismatch:
+		return TEXT("levelMismatch");
+	case EExternalPackageIssue::NotLevelObject:
+		return TEXT("notLevelObject");
+	}
+
+	return TEXT("unknown");
+}
+
+FString FExternalPackageAnalysis::MakeExternalFolderPath(const FString& LevelPackageName, const TCHAR* ExternalFolderName)
+{
+	// The mount point stays in front, the rest of the level path goes under the external folder
+	const int32 MountPointEndIndex = LevelPackageName.Find(TEXT("/"), ESearchCase::CaseSensitive, ESearchDir::FromStart, 1);
+	if (MountPointEndIndex == INDEX_NONE)
+	{
+		return FString();
+	}
+
+	return LevelPackageName.Left(MountPointEndIndex) / ExternalFolderName + LevelPackageName.Mid(MountPointEndIndex);
+}
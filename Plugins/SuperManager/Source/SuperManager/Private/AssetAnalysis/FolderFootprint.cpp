@@ -0,0 +1,167 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetAnalysis/FolderFootprint.h"
+#include "AssetRegistryModule.h"
+#include "Misc/PackageName.h"
+#include "HAL/FileManager.h"
+
+namespace
+{
+	/** Class given to files no on disk asset accounts for, loose files or packages the registry hasn't seen */
+	const FName OtherFilesClassName(TEXT("Other"));
+
+	struct FFolderNode
+	{
+		int32 ParentIndex = INDEX_NONE;
+		int32 Depth = 0;
+		FFolderFootprintEntry Entry;
+	};
+
+	int32 FindOrAddFolder(const FString& FolderPath, TMap<FString, int32>& FolderIndices, TArray<FFolderNode>& FolderNodes)
+	{
+		if (const int32* FolderIndex = FolderIndices.Find(FolderPath))
+		{
+			return *FolderIndex;
+		}
+
+		// The root is added first, every other folder hangs below it
+		int32 ParentIndex = INDEX_NONE;
+		int32 LastSlashIndex = INDEX_NONE;
+		if (FolderPath.FindLastChar(TEXT('/'), LastSlashIndex) && FolderNodes.Num() > 0)
+		{
+			ParentIndex = FindOrAddFolder(FolderPath.Left(LastSlashIndex), FolderIndices, FolderNodes);
+		}
+
+		const int32 FolderIndex = FolderNodes.AddDefaulted();
+		FFolderNode& FolderNode = FolderNodes[FolderIndex];
+		FolderNode.ParentIndex = ParentIndex;
+		FolderNode.Depth = ParentIndex != INDEX_NONE ? FolderNodes[ParentIndex].Depth + 1 : 0;
+		FolderNode.Entry.Name = FName(*FolderPath);
+
+		FolderIndices.Add(FolderPath, FolderIndex);
+		return FolderIndex;
+	}
+}
+
+TSharedRef<const FFolderFootprint, ESPMode::ThreadSafe> FFolderFootprint::Compute(const FString& InRootPath)
+{
+	const double ComputeStartTime = FPlatformTime::Seconds();
+
+	TSharedRef<FFolderFootprint, ESPMode::ThreadSafe> Footprint = MakeShared<FFolderFootprint, ESPMode::ThreadSafe>();
+	Footprint->RootPath = InRootPath;
+	Footprint->RootPath.RemoveFromEnd(TEXT("/"));
+	Footprint->ComputedAt = FDateTime::Now();
+
+	FString RootDirectory;
+	if (!FPackageName::TryConvertLongPackageNameToFilename(Footprint->RootPath + TEXT("/"), RootDirectory))
+	{
+		return Footprint;
+	}
+	RootDirectory = FPaths::ConvertRelativePathToFull(RootDirectory);
+
+	// Only on disk assets, in memory ones can't be enumerated off the game thread and have no file anyway
+	TMap<FName, FName> PackageClassNames;
+	{
+		FARFilter Filter;
+		Filter.bRecursivePaths = true;
+		Filter.bIncludeOnlyOnDiskAssets = true;
+		Filter.PackagePaths.Emplace(*Footprint->RootPath);
+
+		TArray<FAssetData> AssetsData;
+		IAssetRegistry::GetChecked().GetAssets(Filter, AssetsData);
+
+		PackageClassNames.Reserve(AssetsData.Num());
+		for (const FAssetData& AssetData : AssetsData)
+		{
+			PackageClassNames.FindOrAdd(AssetData.PackageName, AssetData.AssetClass);
+		}
+	}
+
+	TMap<FString, int32> FolderIndices;
+	TArray<FFolderNode> FolderNodes;
+	TMap<FName, FFolderFootprintEntry> ClassEntries;
+
+	const int32 RootIndex = FindOrAddFolder(Footprint->RootPath, FolderIndices, FolderNodes);
+	check(RootIndex == 0);
+
+	IFileManager::Get().IterateDirectoryStatRecursively(*RootDirectory, [&](const TCHAR* Filename, const FFileStatData& StatData)
+	{
+		if (StatData.bIsDirectory)
+		{
+			FindOrAddFolder(Footprint->RootPath / FString(Filename).RightChop(RootDirectory.Len()), FolderIndices, FolderNodes);
+			return true;
+		}
+
+		const FString RelativeFilename = FString(Filename).RightChop(RootDirectory.Len());
+
+		// Package name without extension, shared by the .uasset and its payload files
+		const FString RelativePackageName = FPaths::GetBaseFilename(RelativeFilename, false);
+		const FString RelativeFolderPath = FPaths::GetPath(RelativeFilename);
+
+		const FString FolderPath = RelativeFolderPath.IsEmpty() ? Footprint->RootPath : Footprint->RootPath / RelativeFolderPath;
+		const int32 FolderIndex = FindOrAddFolder(FolderPath, FolderIndices, FolderNodes);
+
+		FFolderFootprintEntry& FolderEntry = FolderNodes[FolderIndex].Entry;
+		FolderEntry.OwnBytes += StatData.FileSize;
+
+		const FName PackageName(*(Footprint->RootPath / RelativePackageName), FNAME_Find);
+		const FName* ClassName = PackageClassNames.Find(PackageName);
+
+		FFolderFootprintEntry& ClassEntry = ClassEntries.FindOrAdd(ClassName ? *ClassName : OtherFilesClassName);
+		ClassEntry.TotalBytes += StatData.FileSize;
+
+		// Payload files belong to a package that is already counted
+		if (FPackageName::IsPackageExtension(*FPaths::GetExtension(RelativeFilename, true)))
+		{
+			++FolderEntry.NumPackages;
+			++ClassEntry.NumPackages;
+		}
+
+		++Footprint->NumFiles;
+		return true;
+	});
+
+	// Deepest folders first, every folder is final by the time it is added to its parent
+	TArray<int32> FolderOrder;
+	FolderOrder.Reserve(FolderNodes.Num());
+	for (int32 FolderIndex = 0; FolderIndex < FolderNodes.Num(); ++FolderIndex)
+	{
+		FolderNodes[FolderIndex].Entry.TotalBytes = FolderNodes[FolderIndex].Entry.OwnBytes;
+		FolderOrder.Add(FolderIndex);
+	}
+
+	FolderOrder.Sort([&FolderNodes](int32 A, int32 B) { return FolderNodes[A].Depth > FolderNodes[B].Depth; });
+
+	for (const int32 FolderIndex : FolderOrder)
+	{
+		const FFolderNode& FolderNode = FolderNodes[FolderIndex];
+		if (FolderNode.ParentIndex != INDEX_NONE)
+		{
+			FolderNodes[FolderNode.ParentIndex].Entry.TotalBytes += FolderNode.Entry.TotalBytes;
+			FolderNodes[FolderNode.ParentIndex].Entry.NumPackages += FolderNode.Entry.NumPackages;
+		}
+	}
+
+	Footprint->TotalBytes = FolderNodes[RootIndex].Entry.TotalBytes;
+
+	Footprint->Folders.Reserve(FolderNodes.Num());
+	for (FFolderNode& FolderNode : FolderNodes)
+	{
+		Footprint->Folders.Add(MoveTemp(FolderNode.Entry));
+	}
+
+	Footprint->Classes.Reserve(ClassEntries.Num());
+	for (TPair<FName, FFolderFootprintEntry>& ClassEntry : ClassEntries)
+	{
+		ClassEntry.Value.Name = ClassEntry.Key;
+		ClassEntry.Value.OwnBytes = ClassEntry.Value.TotalBytes;
+		Footprint->Classes.Add(MoveTemp(ClassEntry.Value));
+	}
+
+	auto IsLarger = [](const FFolderFootprintEntry& A, const FFolderFootprintEntry& B) { return A.TotalBytes > B.TotalBytes; };
+	Footprint->Folders.Sort(IsLarger);
+	Footprint->Classes.Sort(IsLarger);
+
+	Footprint->ComputeSeconds = FPlatformTime::Seconds() - ComputeStartTime;
+	return Footprint;
+}
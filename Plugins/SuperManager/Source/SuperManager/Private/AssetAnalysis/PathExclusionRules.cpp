@@ -0,0 +1,99 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetAnalysis/PathExclusionRules.h"
+#include "Settings/SuperManagerSettings.h"
+
+TUniquePtr<FPathExclusionRules> FPathExclusionRules::CompiledRules;
+
+const FPathExclusionRules& FPathExclusionRules::Get()
+{
+	if (!CompiledRules.IsValid())
+	{
+		Recompile();
+	}
+
+	return *CompiledRules;
+}
+
+void FPathExclusionRules::Recompile()
+{
+	const USuperManagerSettings* SuperManagerSettings = GetDefault<USuperManagerSettings>();
+
+	TArray<FString> ExcludedFolderPaths;
+	for (const FDirectoryPath& ExcludedFolder : SuperManagerSettings->ExcludedFolders)
+	{
+		ExcludedFolderPaths.Add(ExcludedFolder.Path);
+	}
+
+	TUniquePtr<FPathExclusionRules> NewRules = MakeUnique<FPathExclusionRules>();
+	NewRules->Compile(SuperManagerSettings->ExcludedFolderNames, ExcludedFolderPaths);
+
+	CompiledRules = MoveTemp(NewRules);
+}
+
+void FPathExclusionRules::Compile(const TArray<FName>& InExcludedFolderNames, const TArray<FString>& InExcludedFolderPaths)
+{
+	ExcludedFolderNames.Reset();
+	ExcludedFolderPaths.Reset();
+
+	for (const FName& ExcludedFolderName : InExcludedFolderNames)
+	{
+		if (!ExcludedFolderName.IsNone())
+		{
+			ExcludedFolderNames.Add(ExcludedFolderName);
+		}
+	}
+
+	for (FString ExcludedFolderPath : InExcludedFolderPaths)
+	{
+		ExcludedFolderPath.RemoveFromEnd(TEXT("/"));
+		if (!ExcludedFolderPath.IsEmpty())
+		{
+			ExcludedFolderPaths.Add(FName(*ExcludedFolderPath));
+		}
+	}
+}
+
+bool FPathExclusionRules::IsFolderExcluded(FStringView FolderPath) const
+{
+	int32 ComponentStart = 0;
+	while (ComponentStart < FolderPath.Len())
+	{
+		int32 ComponentEnd = ComponentStart;
+		while (ComponentEnd < FolderPath.Len() && FolderPath[ComponentEnd] != TEXT('/'))
+		{
+			++ComponentEnd;
+		}
+
+		if (ComponentEnd > ComponentStart)
+		{
+			// FNAME_Find never adds names, a component nobody configured simply isn't found
+			const FStringView Component = FolderPath.Mid(ComponentStart, ComponentEnd - ComponentStart);
+			if (ExcludedFolderNames.Num() > 0 && ExcludedFolderNames.Contains(FName(Component.Len(), Component.GetData(), FNAME_Find)))
+			{
+				return true;
+			}
+
+			const FStringView FolderPrefix = FolderPath.Left(ComponentEnd);
+			if (ExcludedFolderPaths.Num() > 0 && ExcludedFolderPaths.Contains(FName(FolderPrefix.Len(), FolderPrefix.GetData(), FNAME_Find)))
+			{
+				return true;
+			}
+		}
+
+		ComponentStart = ComponentEnd + 1;
+	}
+
+	return false;
+}
+
+bool FPathExclusionRules::IsPackageExcluded(FStringView PackageName) const
+{
+	int32 LastSlashIndex = INDEX_NONE;
+	if (!PackageName.FindLastChar(TEXT('/'), LastSlashIndex))
+	{
+		return false;
+	}
+
+	return IsFolderExcluded(PackageName.Left(LastSlashIndex));
+}
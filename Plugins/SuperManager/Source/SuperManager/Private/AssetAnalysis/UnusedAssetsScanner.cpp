@@ -0,0 +1,109 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetAnalysis/UnusedAssetsScanner.h"
+#include "AssetAnalysis/AssetReferenceIndex.h"
+#include "AssetAnalysis/ContentAnalysis.h"
+#include "Async/Async.h"
+
+FUnusedAssetsScanner::FUnusedAssetsScanner(TArray<FName>&& InPackageNamesToScan, TSharedPtr<FAssetReferenceIndex, ESPMode::ThreadSafe> InReferenceIndex)
+	: PackageNamesToScan(MoveTemp(InPackageNamesToScan))
+	, ReferenceIndex(InReferenceIndex)
+	, NumScanned(0)
+	, bIsCancelled(false)
+	, bIsComplete(false)
+	, ScanEndTime(0.0)
+{
+
+}
+
+void FUnusedAssetsScanner::Start()
+{
+	ScanStartTime = FPlatformTime::Seconds();
+
+	// The task keeps the scanner alive even if the widget that started it goes away
+	Async(EAsyncExecution::ThreadPool, [Scanner = AsShared()]()
+	{
+		Scanner->Run();
+	});
+}
+
+void FUnusedAssetsScanner::Cancel()
+{
+	bIsCancelled = true;
+}
+
+void FUnusedAssetsScanner::DrainResults(TArray<int32>& OutUnusedIndices)
+{
+	FScopeLock Lock(&PendingResultsLock);
+
+	OutUnusedIndices.Append(PendingResults);
+	PendingResults.Reset();
+}
+
+float FUnusedAssetsScanner::GetProgress() const
+{
+	if (PackageNamesToScan.Num() == 0)
+	{
+		return 1.0f;
+	}
+
+	return static_cast<float>(NumScanned) / static_cast<float>(PackageNamesToScan.Num());
+}
+
+double FUnusedAssetsScanner::GetAssetsPerSecond() const
+{
+	const double EndTime = bIsComplete ? ScanEndTime.load() : FPlatformTime::Seconds();
+	const double ElapsedSeconds = EndTime - ScanStartTime;
+
+	return ElapsedSeconds > 0.0 ? NumScanned / ElapsedSeconds : 0.0;
+}
+
+void FUnusedAssetsScanner::Run()
+{
+	// Without a cached index only the listed packages are queried, each batch is posted as soon as it is classified
+	const bool bUseReferenceIndex = ReferenceIndex.IsValid() && ReferenceIndex->IsBuilt();
+
+	TArray<int32> BatchResults;
+	BatchResults.Reserve(BatchSize);
+
+	TArray<bool> BatchIsUnused;
+
+	for (int32 BatchStart = 0; BatchStart < PackageNamesToScan.Num() && !bIsCancelled; BatchStart += BatchSize)
+	{
+		const int32 BatchEnd = FMath::Min(BatchStart + BatchSize, PackageNamesToScan.Num());
+
+		BatchResults.Reset();
+		if (bUseReferenceIndex)
+		{
+			for (int32 PackageIndex = BatchStart; PackageIndex < BatchEnd; ++PackageIndex)
+			{
+				if (ReferenceIndex->IsPackageUnused(PackageNamesToScan[PackageIndex]))
+				{
+					BatchResults.Add(PackageIndex);
+				}
+			}
+		}
+		else
+		{
+			FContentAnalysis::QueryUnusedPackagesInParallel(MakeArrayView(PackageNamesToScan.GetData() + BatchStart, BatchEnd - BatchStart), BatchIsUnused);
+
+			for (int32 PackageIndex = BatchStart; PackageIndex < BatchEnd; ++PackageIndex)
+			{
+				if (BatchIsUnused[PackageIndex - BatchStart])
+				{
+					BatchResults.Add(PackageIndex);
+				}
+			}
+		}
+
+		{
+			FScopeLock Lock(&PendingResultsLock);
+			PendingResults.Append(BatchResults);
+		}
+
+		NumScanned += BatchEnd - BatchStart;
+	}
+
+	ScanEndTime = FPlatformTime::Seconds();
+	bIsComplete = true;
+}
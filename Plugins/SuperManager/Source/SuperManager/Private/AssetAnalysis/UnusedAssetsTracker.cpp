@@ -0,0 +1,442 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetAnalysis/UnusedAssetsTracker.h"
+#include "AssetAnalysis/AssetReferenceIndex.h"
+#include "AssetAnalysis/ContentAnalysis.h"
+#include "AssetAnalysis/PathExclusionRules.h"
+#include "AssetRegistryModule.h"
+#include "Async/Async.h"
+#include "SuperManagerModule.h"
+#include "DebugHeader.h"
+
+void FUnusedAssetsTracker::Initialize()
+{
+	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
+
+	AssetRegistryModule.Get().OnAssetAdded().AddRaw(this, &FUnusedAssetsTracker::OnAssetAdded);
+	AssetRegistryModule.Get().OnAssetRemoved().AddRaw(this, &FUnusedAssetsTracker::OnAssetRemoved);
+	AssetRegistryModule.Get().OnAssetRenamed().AddRaw(this, &FUnusedAssetsTracker::OnAssetRenamed);
+	AssetRegistryModule.Get().OnAssetUpdated().AddRaw(this, &FUnusedAssetsTracker::OnAssetUpdated);
+
+	bIsInitialized = true;
+
+	// The snapshot can only be revalidated against a fully discovered registry
+	if (AssetRegistryModule.Get().IsLoadingAssets())
+	{
+		AssetRegistryModule.Get().OnFilesLoaded().AddRaw(this, &FUnusedAssetsTracker::OnAssetRegistryFilesLoaded);
+	}
+	else
+	{
+		StartReferenceIndexBuild();
+	}
+}
+
+void FUnusedAssetsTracker::Shutdown()
+{
+	if (!bIsInitialized)
+	{
+		return;
+	}
+
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>(TEXT("AssetRegistry")))
+	{
+		AssetRegistryModule->Get().OnAssetAdded().RemoveAll(this);
+		AssetRegistryModule->Get().OnAssetRemoved().RemoveAll(this);
+		AssetRegistryModule->Get().OnAssetRenamed().RemoveAll(this);
+		AssetRegistryModule->Get().OnAssetUpdated().RemoveAll(this);
+		AssetRegistryModule->Get().OnFilesLoaded().RemoveAll(this);
+	}
+
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+
+	// Its game thread callback is dropped once the tracker is shut down
+	bIsInitialized = false;
+
+	if (BuildTask.IsValid())
+	{
+		BuildTask.Wait();
+		BuildTask = TFuture<void>();
+	}
+
+	SaveReferenceIndexSnapshot();
+
+	ReferenceIndex.Reset();
+	ReferenceIndexSnapshot.Reset();
+	DirtyPackageNames.Empty();
+	UnusedPackageNames.Empty();
+	UnusedPackagesPerFolder.Empty();
+}
+
+TSharedPtr<FAssetReferenceIndex, ESPMode::ThreadSafe> FUnusedAssetsTracker::GetReferenceIndexIfBuilt()
+{
+	ApplyPendingChanges();
+	return ReferenceIndex;
+}
+
+void FUnusedAssetsTracker::InvalidateReferenceIndex()
+{
+	// Keep the stale index around, the next build only requeries packages saved since
+	if (ReferenceIndex.IsValid())
+	{
+		ReferenceIndexSnapshot = ReferenceIndex;
+		SetReferenceIndex(nullptr);
+	}
+
+	++ReferenceIndexGeneration;
+
+	StartReferenceIndexBuild();
+}
+
+void FUnusedAssetsTracker::SaveReferenceIndexSnapshot()
+{
+	TSharedPtr<FAssetReferenceIndex, ESPMode::ThreadSafe> IndexToSave = ReferenceIndex.IsValid() ? ReferenceIndex : ReferenceIndexSnapshot;
+	if (IndexToSave.IsValid() && !IndexToSave->SaveToFile(FAssetReferenceIndex::GetSnapshotFilePath()))
+	{
+		DebugHeader::PrintLog(TEXT("Failed to save SuperManager reference index snapshot"));
+	}
+}
+
+bool FUnusedAssetsTracker::IsPackageUnused(FName PackageName)
+{
+	if (GetReferenceIndexIfBuilt().IsValid())
+	{
+		return UnusedPackageNames.Contains(PackageName);
+	}
+
+	// Not indexed yet, a single package is cheap to ask the registry about
+	TArray<FName> Referencers;
+	IAssetRegistry::GetChecked().GetReferencers(PackageName, Referencers, UE::AssetRegistry::EDependencyCategory::Package);
+
+	return Referencers.Num() == 0;
+}
+
+int32 FUnusedAssetsTracker::GetNumUnusedPackagesUnderFolder(const FString& FolderPath)
+{
+	if (!GetReferenceIndexIfBuilt().IsValid())
+	{
+		return INDEX_NONE;
+	}
+
+	FString FolderPathWithoutSlash = FolderPath;
+	FolderPathWithoutSlash.RemoveFromEnd(TEXT("/"));
+
+	const FString SubfolderPrefix = FolderPathWithoutSlash + TEXT("/");
+
+	// Only folders that hold unused packages have an entry, so this stays small
+	int32 NumUnusedPackages = 0;
+	for (const TPair<FName, TSet<FName>>& FolderUnusedPackages : UnusedPackagesPerFolder)
+	{
+		const FString FolderName = FolderUnusedPackages.Key.ToString();
+		if (FolderName == FolderPathWithoutSlash || FolderName.StartsWith(SubfolderPrefix))
+		{
+			NumUnusedPackages += FolderUnusedPackages.Value.Num();
+		}
+	}
+
+	return NumUnusedPackages;
+}
+
+void FUnusedAssetsTracker::GetUnusedAssetsUnderFolders(const TArray<FString>& FolderPaths, TArray<FAssetData>& OutUnusedAssetsData)
+{
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	const FPathExclusionRules& ExclusionRules = FPathExclusionRules::Get();
+
+	FARFilter Filter;
+
+	if (GetReferenceIndexIfBuilt().IsValid())
+	{
+		// Overlapping selections collapse to their topmost folders, every folder entry is then matched once
+		TArray<FString> RootFolderPaths;
+		FContentAnalysis::CollapseNestedFolders(FolderPaths, RootFolderPaths);
+
+		const TSet<FString> RootFolderPathsSet(RootFolderPaths);
+		if (RootFolderPathsSet.Num() == 0)
+		{
+			return;
+		}
+
+		for (const TPair<FName, TSet<FName>>& FolderUnusedPackages : UnusedPackagesPerFolder)
+		{
+			const FString FolderName = FolderUnusedPackages.Key.ToString();
+			if (ExclusionRules.IsFolderExcluded(FolderName))
+			{
+				continue;
+			}
+
+			bool bIsUnderRoot = RootFolderPathsSet.Contains(FolderName);
+
+			int32 LastSlashIndex = INDEX_NONE;
+			FString AncestorPath = FolderName;
+			while (!bIsUnderRoot && AncestorPath.FindLastChar(TEXT('/'), LastSlashIndex) && LastSlashIndex > 0)
+			{
+				AncestorPath.LeftInline(LastSlashIndex, false);
+				bIsUnderRoot = RootFolderPathsSet.Contains(AncestorPath);
+			}
+
+			if (bIsUnderRoot)
+			{
+				Filter.PackageNames.Append(FolderUnusedPackages.Value.Array());
+			}
+		}
+	}
+	else
+	{
+		// Not indexed yet, ask the registry about every package in the folders instead of waiting for the build
+		TArray<FAssetData> FolderAssetsData;
+		FContentAnalysis::GatherAssetsUnderFolders(FolderPaths, FolderAssetsData);
+
+		TSet<FName> FolderPackageNamesSet;
+		for (const FAssetData& FolderAssetData : FolderAssetsData)
+		{
+			FolderPackageNamesSet.Add(FolderAssetData.PackageName);
+		}
+
+		const TArray<FName> FolderPackageNames = FolderPackageNamesSet.Array();
+
+		TArray<bool> IsUnused;
+		FContentAnalysis::QueryUnusedPackagesInParallel(FolderPackageNames, IsUnused);
+
+		for (int32 PackageIndex = 0; PackageIndex < FolderPackageNames.Num(); ++PackageIndex)
+		{
+			if (IsUnused[PackageIndex])
+			{
+				Filter.PackageNames.Add(FolderPackageNames[PackageIndex]);
+			}
+		}
+	}
+
+	if (Filter.PackageNames.Num() > 0)
+	{
+		AssetRegistry.GetAssets(Filter, OutUnusedAssetsData);
+	}
+}
+
+void FUnusedAssetsTracker::OnAssetAdded(const FAssetData& AssetData)
+{
+	MarkPackageDirty(AssetData.PackageName);
+}
+
+void FUnusedAssetsTracker::OnAssetRemoved(const FAssetData& AssetData)
+{
+	MarkPackageDirty(AssetData.PackageName);
+}
+
+void FUnusedAssetsTracker::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	MarkPackageDirty(AssetData.PackageName);
+	MarkPackageDirty(FName(*FPackageName::ObjectPathToPackageName(OldObjectPath)));
+}
+
+void FUnusedAssetsTracker::OnAssetUpdated(const FAssetData& AssetData)
+{
+	MarkPackageDirty(AssetData.PackageName);
+}
+
+void FUnusedAssetsTracker::OnAssetRegistryFilesLoaded()
+{
+	// Anything built while the registry was still discovering files is incomplete
+	if (ReferenceIndex.IsValid())
+	{
+		InvalidateReferenceIndex();
+	}
+	else
+	{
+		StartReferenceIndexBuild();
+	}
+}
+
+void FUnusedAssetsTracker::MarkPackageDirty(FName PackageName)
+{
+	// The initial discovery is picked up by the build that follows it
+	if (IAssetRegistry::GetChecked().IsLoadingAssets())
+	{
+		return;
+	}
+
+	DirtyPackageNames.Add(PackageName);
+
+	// Coalesce bursts of events, e.g. a source control sync, into a single update
+	if (ReferenceIndex.IsValid() && !TickerHandle.IsValid())
+	{
+		TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FUnusedAssetsTracker::OnTick), 0.25f);
+	}
+}
+
+bool FUnusedAssetsTracker::OnTick(float DeltaTime)
+{
+	TickerHandle.Reset();
+	ApplyPendingChanges();
+
+	return false;
+}
+
+void FUnusedAssetsTracker::ApplyPendingChanges()
+{
+	if (DirtyPackageNames.Num() == 0 || !ReferenceIndex.IsValid())
+	{
+		return;
+	}
+
+	// Background tasks may still be reading the current index, patch a private copy instead
+	if (!ReferenceIndex.IsUnique())
+	{
+		ReferenceIndex = MakeShared<FAssetReferenceIndex, ESPMode::ThreadSafe>(*ReferenceIndex);
+	}
+
+	TArray<int32> AffectedPackageIndices;
+	for (const FName& DirtyPackageName : DirtyPackageNames)
+	{
+		ReferenceIndex->UpdatePackage(DirtyPackageName, AffectedPackageIndices);
+	}
+
+	DirtyPackageNames.Empty();
+
+	// Listeners also get packages whose referencer count moved without flipping, e.g. to refresh a count column
+	TSet<int32> ChangedPackageIndices;
+	TArray<FName> ChangedPackageNames;
+
+	for (const int32 AffectedPackageIndex : AffectedPackageIndices)
+	{
+		bool bIsAlreadyChanged = false;
+		ChangedPackageIndices.Add(AffectedPackageIndex, &bIsAlreadyChanged);
+
+		if (!bIsAlreadyChanged)
+		{
+			UpdateUnusedState(AffectedPackageIndex);
+			ChangedPackageNames.Add(ReferenceIndex->GetPackageName(AffectedPackageIndex));
+		}
+	}
+
+	UnusedAssetsChangedEvent.Broadcast(ChangedPackageNames);
+}
+
+void FUnusedAssetsTracker::StartReferenceIndexBuild()
+{
+	// A running build is redone when it finishes if it was invalidated meanwhile
+	if (BuildTask.IsValid() || IAssetRegistry::GetChecked().IsLoadingAssets())
+	{
+		return;
+	}
+
+	const uint32 BuildGeneration = ReferenceIndexGeneration;
+	TSharedPtr<FAssetReferenceIndex, ESPMode::ThreadSafe> Snapshot = ReferenceIndexSnapshot;
+
+	// Revalidate the snapshot off the game thread, nothing waits on it
+	BuildTask = Async(EAsyncExecution::ThreadPool, [Snapshot, BuildGeneration]() mutable
+	{
+		if (!Snapshot.IsValid())
+		{
+			Snapshot = MakeShared<FAssetReferenceIndex, ESPMode::ThreadSafe>();
+			if (!Snapshot->LoadFromFile(FAssetReferenceIndex::GetSnapshotFilePath()))
+			{
+				Snapshot.Reset();
+			}
+		}
+
+		TSharedPtr<FAssetReferenceIndex, ESPMode::ThreadSafe> BuiltReferenceIndex = MakeShared<FAssetReferenceIndex, ESPMode::ThreadSafe>();
+		BuiltReferenceIndex->Build(Snapshot.Get());
+
+		DebugHeader::PrintLog(FString::Printf(TEXT("SuperManager reference index ready, %d packages, %d revalidated since last snapshot"),
+			BuiltReferenceIndex->Num(), BuiltReferenceIndex->GetNumRevalidatedPackages()));
+
+		AsyncTask(ENamedThreads::GameThread, [BuiltReferenceIndex, BuildGeneration]()
+		{
+			// The module may have been unloaded while the index was being built
+			if (FSuperManagerModule* SuperManagerModule = FModuleManager::GetModulePtr<FSuperManagerModule>(TEXT("SuperManager")))
+			{
+				SuperManagerModule->GetUnusedAssetsTracker().OnReferenceIndexBuilt(BuiltReferenceIndex, BuildGeneration);
+			}
+		});
+	});
+}
+
+void FUnusedAssetsTracker::OnReferenceIndexBuilt(TSharedPtr<FAssetReferenceIndex, ESPMode::ThreadSafe> BuiltReferenceIndex, uint32 BuiltAtGeneration)
+{
+	if (!bIsInitialized)
+	{
+		return;
+	}
+
+	BuildTask = TFuture<void>();
+
+	// Invalidated while it was being built, it's still the closest starting point for the rebuild
+	if (BuiltAtGeneration != ReferenceIndexGeneration)
+	{
+		ReferenceIndexSnapshot = BuiltReferenceIndex;
+		StartReferenceIndexBuild();
+		return;
+	}
+
+	SetReferenceIndex(BuiltReferenceIndex);
+	SaveReferenceIndexSnapshot();
+
+	// Registry changes that arrived while it was being built may not be in it yet
+	ApplyPendingChanges();
+
+	ReferenceIndexReadyEvent.Broadcast();
+}
+
+void FUnusedAssetsTracker::SetReferenceIndex(TSharedPtr<FAssetReferenceIndex, ESPMode::ThreadSafe> NewReferenceIndex)
+{
+	ReferenceIndex = NewReferenceIndex;
+
+	if (ReferenceIndex.IsValid())
+	{
+		ReferenceIndexSnapshot.Reset();
+	}
+
+	RebuildUnusedPackages();
+}
+
+void FUnusedAssetsTracker::RebuildUnusedPackages()
+{
+	UnusedPackageNames.Reset();
+	UnusedPackagesPerFolder.Reset();
+
+	if (!ReferenceIndex.IsValid())
+	{
+		return;
+	}
+
+	for (int32 PackageIndex = 0; PackageIndex < ReferenceIndex->Num(); ++PackageIndex)
+	{
+		UpdateUnusedState(PackageIndex);
+	}
+}
+
+void FUnusedAssetsTracker::UpdateUnusedState(int32 PackageIndex)
+{
+	const FName PackageName = ReferenceIndex->GetPackageName(PackageIndex);
+	const bool bIsUnused = EnumHasAnyFlags(ReferenceIndex->GetPackageFlags(PackageIndex), EIndexedPackageFlags::ContainsAssets)
+		&& ReferenceIndex->GetPackageReferencerCount(PackageIndex) == 0;
+
+	if (bIsUnused == UnusedPackageNames.Contains(PackageName))
+	{
+		return;
+	}
+
+	const FName FolderName(*FPackageName::GetLongPackagePath(PackageName.ToString()));
+
+	if (bIsUnused)
+	{
+		UnusedPackageNames.Add(PackageName);
+		UnusedPackagesPerFolder.FindOrAdd(FolderName).Add(PackageName);
+	}
+	else
+	{
+		UnusedPackageNames.Remove(PackageName);
+
+		TSet<FName>& FolderUnusedPackages = UnusedPackagesPerFolder.FindChecked(FolderName);
+		FolderUnusedPackages.Remove(PackageName);
+
+		if (FolderUnusedPackages.Num() == 0)
+		{
+			UnusedPackagesPerFolder.Remove(FolderName);
+		}
+	}
+}
@@ -0,0 +1,325 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Commandlets/SuperManagerAuditCommandlet.h"
+#include "AssetAnalysis/ContentAnalysis.h"
+#include "AssetAnalysis/AssetReferenceIndex.h"
+#include "AssetAnalysis/AssetReachabilityAnalysis.h"
+#include "AssetAnalysis/DeletionPlan.h"
+#include "AssetAnalysis/ExternalPackageAnalysis.h"
+#include "ObjectTools.h"
+#include "AssetRegistryModule.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Misc/FileHelper.h"
+#include "Algo/Count.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSuperManagerAudit, Log, All);
+
+USuperManagerAuditCommandlet::USuperManagerAuditCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32 USuperManagerAuditCommandlet::Main(const FString& Params)
+{
+	FString RootPath = TEXT("/Game");
+	FParse::Value(*Params, TEXT("Root="), RootPath);
+
+	FString ReportFilePath = FPaths::ProjectSavedDir() / TEXT("SuperManager") / TEXT("AuditReport.json");
+	FParse::Value(*Params, TEXT("Report="), ReportFilePath);
+
+	FString PhasesParam;
+	if (FParse::Value(*Params, TEXT("Phases="), PhasesParam))
+	{
+		PhasesParam.ParseIntoArray(PhasesToRun, TEXT(","));
+	}
+
+	ReportObject = MakeShared<FJsonObject>();
+	ReportObject->SetStringField(TEXT("root"), RootPath);
+	ReportObject->SetStringField(TEXT("timestamp"), FDateTime::UtcNow().ToIso8601());
+	PhaseReports.Empty();
+
+	// Commandlets don't get a background registry scan, do it up front
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	RunPhase(TEXT("registryscan"), [&AssetRegistry](int32& OutNumProcessed, int32& OutNumFound)
+	{
+		AssetRegistry.SearchAllAssets(true);
+
+		TArray<FAssetData> AllAssetsData;
+		AssetRegistry.GetAllAssets(AllAssetsData, true);
+		OutNumProcessed = AllAssetsData.Num();
+		OutNumFound = AllAssetsData.Num();
+	});
+
+	TArray<FAssetData> AssetsData;
+	RunPhase(TEXT("gather"), [&RootPath, &AssetsData](int32& OutNumProcessed, int32& OutNumFound)
+	{
+		FContentAnalysis::GatherAssetsUnderFolder(RootPath, AssetsData);
+		OutNumProcessed = AssetsData.Num();
+		OutNumFound = AssetsData.Num();
+	});
+
+	TSharedRef<FAssetReferenceIndex, ESPMode::ThreadSafe> ReferenceIndex = MakeShared<FAssetReferenceIndex, ESPMode::ThreadSafe>();
+	if (ShouldRunPhase(TEXT("unused")) || ShouldRunPhase(TEXT("unreachable")))
+	{
+		RunPhase(TEXT("referenceindex"), [&ReferenceIndex](int32& OutNumProcessed, int32& OutNumFound)
+		{
+			ReferenceIndex->Build();
+			OutNumProcessed = ReferenceIndex->Num();
+			OutNumFound = ReferenceIndex->Num();
+		});
+	}
+
+	if (ShouldRunPhase(TEXT("unused")))
+	{
+		TArray<FAssetData> UnusedAssetsData;
+		RunPhase(TEXT("unused"), [&AssetsData, &ReferenceIndex, &UnusedAssetsData](int32& OutNumProcessed, int32& OutNumFound)
+		{
+			FContentAnalysis::FindUnusedAssets(AssetsData, *ReferenceIndex, UnusedAssetsData);
+			OutNumProcessed = AssetsData.Num();
+			OutNumFound = UnusedAssetsData.Num();
+		});
+
+		AddAssetsToReport(TEXT("unusedAssets"), UnusedAssetsData);
+
+		if (FParse::Param(*Params, TEXT("PlanUnused")))
+		{
+			FDeletionPlan DeletionPlan;
+			RunPhase(TEXT("deletionplan"), [&UnusedAssetsData, &DeletionPlan](int32& OutNumProcessed, int32& OutNumFound)
+			{
+				DeletionPlan.Build(UnusedAssetsData);
+				OutNumProcessed = UnusedAssetsData.Num();
+				OutNumFound = DeletionPlan.GetFoldersBecomingEmpty().Num();
+			});
+
+			ReportObject->SetObjectField(TEXT("deletionPlan"), DeletionPlan.ToJson());
+		}
+	}
+
+	if (ShouldRunPhase(TEXT("unreachable")))
+	{
+		TArray<FAssetData> UnreachableAssetsData;
+		RunPhase(TEXT("unreachable"), [&AssetsData, &ReferenceIndex, &UnreachableAssetsData](int32& OutNumProcessed, int32& OutNumFound)
+		{
+			FAssetReachabilityAnalysis ReachabilityAnalysis(ReferenceIndex);
+			ReachabilityAnalysis.Run();
+
+			FContentAnalysis::FindUnreachableAssets(AssetsData, ReachabilityAnalysis, UnreachableAssetsData);
+			OutNumProcessed = ReferenceIndex->Num();
+			OutNumFound = UnreachableAssetsData.Num();
+		});
+
+		AddAssetsToReport(TEXT("unreachableAssets"), UnreachableAssetsData);
+	}
+
+	if (FParse::Param(*Params, TEXT("Benchmark")))
+	{
+		RunReferencerQueryBenchmark(AssetsData);
+	}
+
+	if (ShouldRunPhase(TEXT("samename")))
+	{
+		TArray<FAssetData> SameNameAssetsData;
+		RunPhase(TEXT("samename"), [&AssetsData, &SameNameAssetsData](int32& OutNumProcessed, int32& OutNumFound)
+		{
+			FContentAnalysis::FindSameNameAssets(AssetsData, SameNameAssetsData);
+			OutNumProcessed = AssetsData.Num();
+			OutNumFound = SameNameAssetsData.Num();
+		});
+
+		AddAssetsToReport(TEXT("sameNameAssets"), SameNameAssetsData);
+	}
+
+	if (ShouldRunPhase(TEXT("emptyfolders")))
+	{
+		TArray<FString> EmptyFolderPaths;
+		RunPhase(TEXT("emptyfolders"), [&RootPath, &EmptyFolderPaths, &AssetRegistry](int32& OutNumProcessed, int32& OutNumFound)
+		{
+			TArray<FString> RootPathArray;
+			RootPathArray.Add(RootPath);
+			FContentAnalysis::FindEmptyFolders(RootPathArray, EmptyFolderPaths);
+
+			TArray<FString> SubPaths;
+			AssetRegistry.GetSubPaths(RootPath, SubPaths, true);
+			OutNumProcessed = SubPaths.Num() + 1;
+			OutNumFound = EmptyFolderPaths.Num();
+		});
+
+		AddPathsToReport(TEXT("emptyFolders"), EmptyFolderPaths);
+	}
+
+	if (ShouldRunPhase(TEXT("redirectors")))
+	{
+		TArray<FAssetData> RedirectorsData;
+		RunPhase(TEXT("redirectors"), [&RootPath, &AssetsData, &RedirectorsData](int32& OutNumProcessed, int32& OutNumFound)
+		{
+			FContentAnalysis::FindRedirectors(RootPath, RedirectorsData);
+			OutNumProcessed = AssetsData.Num();
+			OutNumFound = RedirectorsData.Num();
+		});
+
+		AddAssetsToReport(TEXT("redirectors"), RedirectorsData);
+	}
+
+	if (ShouldRunPhase(TEXT("externalpackages")))
+	{
+		FExternalPackageAnalysis ExternalPackageAnalysis;
+		RunPhase(TEXT("externalpackages"), [&ExternalPackageAnalysis](int32& OutNumProcessed, int32& OutNumFound)
+		{
+			// The registry was searched synchronously above, so it is never still loading here
+			if (!ExternalPackageAnalysis.Run())
+			{
+				UE_LOG(LogSuperManagerAudit, Error, TEXT("The Asset Registry is still discovering assets, external packages were not analyzed"));
+			}
+			OutNumProcessed = ExternalPackageAnalysis.GetNumExternalPackages();
+			OutNumFound = ExternalPackageAnalysis.GetOrphanedPackages().Num();
+		});
+
+		TArray<TSharedPtr<FJsonValue>> OrphanedValues;
+		OrphanedValues.Reserve(ExternalPackageAnalysis.GetOrphanedPackages().Num());
+		for (const FOrphanedExternalPackage& OrphanedPackage : ExternalPackageAnalysis.GetOrphanedPackages())
+		{
+			TSharedRef<FJsonObject> OrphanedObject = MakeShared<FJsonObject>();
+			OrphanedObject->SetStringField(TEXT("objectPath"), OrphanedPackage.AssetData.ObjectPath.ToString());
+			OrphanedObject->SetStringField(TEXT("folderLevel"), OrphanedPackage.FolderLevelPackageName.IsNone() ? FString() : OrphanedPackage.FolderLevelPackageName.ToString());
+			OrphanedObject->SetStringField(TEXT("issue"), FExternalPackageAnalysis::LexToString(OrphanedPackage.Issue));
+			OrphanedValues.Add(MakeShared<FJsonValueObject>(OrphanedObject));
+		}
+		ReportObject->SetArrayField(TEXT("orphanedExternalPackages"), OrphanedValues);
+
+		if (FParse::Param(*Params, TEXT("CleanupExternal")) && OrphanedValues.Num() > 0)
+		{
+			TArray<FAssetData> OrphanedAssetsData;
+			ExternalPackageAnalysis.GetOrphanedAssetsData(OrphanedAssetsData);
+
+			// External packages always go through the editor's deletion, never straight off the disk
+			RunPhase(TEXT("externalcleanup"), [&OrphanedAssetsData](int32& OutNumProcessed, int32& OutNumFound)
+			{
+				OutNumProcessed = OrphanedAssetsData.Num();
+				OutNumFound = OrphanedAssetsData.Num() > 0 ? ObjectTools::DeleteAssets(OrphanedAssetsData, false) : 0;
+			});
+
+			if (OrphanedAssetsData.Num() != OrphanedValues.Num())
+			{
+				UE_LOG(LogSuperManagerAudit, Display, TEXT("Kept %d external packages whose level exists on disk"), OrphanedValues.Num() - OrphanedAssetsData.Num());
+			}
+		}
+	}
+
+	ReportObject->SetArrayField(TEXT("phases"), PhaseReports);
+
+	FString ReportString;
+	TSharedRef<TJsonWriter<>> ReportWriter = TJsonWriterFactory<>::Create(&ReportString);
+	if (!FJsonSerializer::Serialize(ReportObject.ToSharedRef(), ReportWriter) || !FFileHelper::SaveStringToFile(ReportString, *ReportFilePath))
+	{
+		UE_LOG(LogSuperManagerAudit, Error, TEXT("Failed to write audit report to %s"), *ReportFilePath);
+		return 1;
+	}
+
+	UE_LOG(LogSuperManagerAudit, Display, TEXT("Audit report written to %s"), *ReportFilePath);
+	return 0;
+}
+
+void USuperManagerAuditCommandlet::RunPhase(const FString& PhaseName, TFunctionRef<void(int32& OutNumProcessed, int32& OutNumFound)> PhaseBody)
+{
+	int32 NumProcessed = 0;
+	int32 NumFound = 0;
+
+	const double PhaseStartTime = FPlatformTime::Seconds();
+	PhaseBody(NumProcessed, NumFound);
+	const double PhaseSeconds = FPlatformTime::Seconds() - PhaseStartTime;
+
+	const double ItemsPerSecond = PhaseSeconds > 0.0 ? NumProcessed / PhaseSeconds : 0.0;
+
+	TSharedRef<FJsonObject> PhaseObject = MakeShared<FJsonObject>();
+	PhaseObject->SetStringField(TEXT("name"), PhaseName);
+	PhaseObject->SetNumberField(TEXT("seconds"), PhaseSeconds);
+	PhaseObject->SetNumberField(TEXT("processed"), NumProcessed);
+	PhaseObject->SetNumberField(TEXT("found"), NumFound);
+	PhaseObject->SetNumberField(TEXT("itemsPerSecond"), ItemsPerSecond);
+	PhaseReports.Add(MakeShared<FJsonValueObject>(PhaseObject));
+
+	UE_LOG(LogSuperManagerAudit, Display, TEXT("%-16s %8.3fs  processed %8d  found %8d  (%.0f items/sec)"), *PhaseName, PhaseSeconds, NumProcessed, NumFound, ItemsPerSecond);
+}
+
+void USuperManagerAuditCommandlet::AddAssetsToReport(const FString& FieldName, const TArray<FAssetData>& AssetsData)
+{
+	TArray<TSharedPtr<FJsonValue>> AssetValues;
+	AssetValues.Reserve(AssetsData.Num());
+
+	for (const FAssetData& AssetData : AssetsData)
+	{
+		AssetValues.Add(MakeShared<FJsonValueString>(AssetData.ObjectPath.ToString()));
+	}
+
+	ReportObject->SetArrayField(FieldName, AssetValues);
+}
+
+void USuperManagerAuditCommandlet::AddPathsToReport(const FString& FieldName, const TArray<FString>& Paths)
+{
+	TArray<TSharedPtr<FJsonValue>> PathValues;
+	PathValues.Reserve(Paths.Num());
+
+	for (const FString& Path : Paths)
+	{
+		PathValues.Add(MakeShared<FJsonValueString>(Path));
+	}
+
+	ReportObject->SetArrayField(FieldName, PathValues);
+}
+
+void USuperManagerAuditCommandlet::RunReferencerQueryBenchmark(const TArray<FAssetData>& AssetsData)
+{
+	TArray<FName> PackageNames;
+	PackageNames.Reserve(AssetsData.Num());
+
+	for (const FAssetData& AssetData : AssetsData)
+	{
+		PackageNames.Add(AssetData.PackageName);
+	}
+
+	TArray<bool> SerialIsUnused;
+	const double SerialStartTime = FPlatformTime::Seconds();
+	RunPhase(TEXT("serialreferencers"), [&PackageNames, &SerialIsUnused](int32& OutNumProcessed, int32& OutNumFound)
+	{
+		FContentAnalysis::QueryUnusedPackages(PackageNames, SerialIsUnused);
+		OutNumProcessed = PackageNames.Num();
+		OutNumFound = Algo::Count(SerialIsUnused, true);
+	});
+	const double SerialSeconds = FPlatformTime::Seconds() - SerialStartTime;
+
+	TArray<bool> ParallelIsUnused;
+	const double ParallelStartTime = FPlatformTime::Seconds();
+	RunPhase(TEXT("parallelreferencers"), [&PackageNames, &ParallelIsUnused](int32& OutNumProcessed, int32& OutNumFound)
+	{
+		FContentAnalysis::QueryUnusedPackagesInParallel(PackageNames, ParallelIsUnused);
+		OutNumProcessed = PackageNames.Num();
+		OutNumFound = Algo::Count(ParallelIsUnused, true);
+	});
+	const double ParallelSeconds = FPlatformTime::Seconds() - ParallelStartTime;
+
+	if (SerialIsUnused != ParallelIsUnused)
+	{
+		UE_LOG(LogSuperManagerAudit, Warning, TEXT("Serial and parallel referencer queries disagree"));
+	}
+
+	const double Speedup = ParallelSeconds > 0.0 ? SerialSeconds / ParallelSeconds : 0.0;
+	const int32 NumWorkerThreads = FTaskGraphInterface::Get().GetNumWorkerThreads();
+
+	TSharedRef<FJsonObject> BenchmarkObject = MakeShared<FJsonObject>();
+	BenchmarkObject->SetNumberField(TEXT("workerThreads"), NumWorkerThreads);
+	BenchmarkObject->SetNumberField(TEXT("speedup"), Speedup);
+	BenchmarkObject->SetBoolField(TEXT("resultsMatch"), SerialIsUnused == ParallelIsUnused);
+	ReportObject->SetObjectField(TEXT("referencerQueryBenchmark"), BenchmarkObject);
+
+	UE_LOG(LogSuperManagerAudit, Display, TEXT("Parallel referencer queries: %.2fx speedup on %d worker threads"), Speedup, NumWorkerThreads);
+}
+
+bool USuperManagerAuditCommandlet::ShouldRunPhase(const FString& PhaseName) const
+{
+	return PhasesToRun.Num() == 0 || PhasesToRun.Contains(PhaseName);
+}
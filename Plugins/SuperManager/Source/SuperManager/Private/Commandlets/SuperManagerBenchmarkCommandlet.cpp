@@ -0,0 +1,397 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Commandlets/SuperManagerBenchmarkCommandlet.h"
+#include "Commandlets/SuperManagerBenchmarkAsset.h"
+#include "AssetAnalysis/ContentAnalysis.h"
+#include "AssetAnalysis/AssetReferenceIndex.h"
+#include "SlateWidgets/AssetListModel.h"
+#include "AssetRegistryModule.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "UObject/SavePackage.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMemory.h"
+#include "Algo/Count.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSuperManagerBenchmark, Log, All);
+
+namespace
+{
+	/** Long package root of the generated content, never mounted outside of the benchmark */
+	const TCHAR* BenchmarkMountPoint = TEXT("/SuperManagerBenchmark/");
+
+	/** Every Nth asset reuses the name of the previous one, in another folder */
+	constexpr int32 SameNameInterval = 10;
+}
+
+USuperManagerBenchmarkCommandlet::USuperManagerBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32 USuperManagerBenchmarkCommandlet::Main(const FString& Params)
+{
+	TArray<int32> Sizes;
+	FString SizesParam = TEXT("1000,10000");
+	FParse::Value(*Params, TEXT("Sizes="), SizesParam);
+	{
+		TArray<FString> SizeStrings;
+		SizesParam.ParseIntoArray(SizeStrings, TEXT(","));
+		for (const FString& SizeString : SizeStrings)
+		{
+			const int32 Size = FCString::Atoi(*SizeString);
+			if (Size > 0)
+			{
+				Sizes.Add(Size);
+			}
+		}
+	}
+
+	FParse::Value(*Params, TEXT("ReferenceDensity="), ReferenceDensity);
+	FParse::Value(*Params, TEXT("FolderDepth="), FolderDepth);
+	FParse::Value(*Params, TEXT("FolderFanout="), FolderFanout);
+	FParse::Value(*Params, TEXT("EmptyFolderRatio="), EmptyFolderRatio);
+	FParse::Value(*Params, TEXT("Seed="), Seed);
+
+	ReferenceDensity = FMath::Max(ReferenceDensity, 0.0f);
+	FolderDepth = FMath::Max(FolderDepth, 0);
+	FolderFanout = FMath::Max(FolderFanout, 1);
+	EmptyFolderRatio = FMath::Clamp(EmptyFolderRatio, 0.0f, 1.0f);
+
+	FString PhasesParam;
+	if (FParse::Value(*Params, TEXT("Phases="), PhasesParam))
+	{
+		PhasesParam.ParseIntoArray(PhasesToRun, TEXT(","));
+	}
+
+	FString ReportFilePath = FPaths::ProjectSavedDir() / TEXT("SuperManager") / TEXT("BenchmarkReport.json");
+	FParse::Value(*Params, TEXT("Report="), ReportFilePath);
+
+	const bool bKeepContent = FParse::Param(*Params, TEXT("KeepContent"));
+
+	// Leftovers of an aborted run would be scanned along with the new content
+	MountContentDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectIntermediateDir() / TEXT("SuperManagerBenchmark/"));
+	IFileManager::Get().DeleteDirectory(*MountContentDir, false, true);
+	IFileManager::Get().MakeDirectory(*MountContentDir, true);
+
+	TSharedRef<FJsonObject> ReportObject = MakeShared<FJsonObject>();
+	ReportObject->SetStringField(TEXT("timestamp"), FDateTime::UtcNow().ToIso8601());
+	ReportObject->SetNumberField(TEXT("referenceDensity"), ReferenceDensity);
+	ReportObject->SetNumberField(TEXT("folderDepth"), FolderDepth);
+	ReportObject->SetNumberField(TEXT("folderFanout"), FolderFanout);
+	ReportObject->SetNumberField(TEXT("emptyFolderRatio"), EmptyFolderRatio);
+	ReportObject->SetNumberField(TEXT("seed"), Seed);
+	ReportObject->SetNumberField(TEXT("workerThreads"), FTaskGraphInterface::Get().GetNumWorkerThreads());
+
+	TArray<TSharedPtr<FJsonValue>> RunReports;
+	bool bSucceeded = true;
+
+	for (const int32 NumAssets : Sizes)
+	{
+		const FString RootPath = FString::Printf(TEXT("%sAssets_%d"), BenchmarkMountPoint, NumAssets);
+		PhaseReports.Empty();
+
+		// Mounted per size, DestroyContent dismounts it again
+		if (!FPackageName::MountPointExists(BenchmarkMountPoint))
+		{
+			FPackageName::RegisterMountPoint(BenchmarkMountPoint, MountContentDir);
+		}
+
+		UE_LOG(LogSuperManagerBenchmark, Display, TEXT("Generating %d assets under %s"), NumAssets, *RootPath);
+
+		const double GenerateStartTime = FPlatformTime::Seconds();
+		if (!GenerateContent(RootPath, NumAssets))
+		{
+			DestroyContent(RootPath);
+			bSucceeded = false;
+			break;
+		}
+		const double GenerateSeconds = FPlatformTime::Seconds() - GenerateStartTime;
+
+		RunBenchmark(RootPath, NumAssets);
+
+		TSharedRef<FJsonObject> RunObject = MakeShared<FJsonObject>();
+		RunObject->SetStringField(TEXT("root"), RootPath);
+		RunObject->SetNumberField(TEXT("numAssets"), NumAssets);
+		RunObject->SetNumberField(TEXT("generateSeconds"), GenerateSeconds);
+		RunObject->SetArrayField(TEXT("phases"), PhaseReports);
+		RunReports.Add(MakeShared<FJsonValueObject>(RunObject));
+
+		if (!bKeepContent)
+		{
+			DestroyContent(RootPath);
+		}
+	}
+
+	if (!bKeepContent)
+	{
+		IFileManager::Get().DeleteDirectory(*MountContentDir, false, true);
+	}
+
+	ReportObject->SetArrayField(TEXT("runs"), RunReports);
+
+	FString ReportString;
+	TSharedRef<TJsonWriter<>> ReportWriter = TJsonWriterFactory<>::Create(&ReportString);
+	if (!FJsonSerializer::Serialize(ReportObject, ReportWriter) || !FFileHelper::SaveStringToFile(ReportString, *ReportFilePath))
+	{
+		UE_LOG(LogSuperManagerBenchmark, Error, TEXT("Failed to write benchmark report to %s"), *ReportFilePath);
+		return 1;
+	}
+
+	UE_LOG(LogSuperManagerBenchmark, Display, TEXT("Benchmark report written to %s"), *ReportFilePath);
+	return bSucceeded ? 0 : 1;
+}
+
+bool USuperManagerBenchmarkCommandlet::GenerateContent(const FString& RootPath, int32 NumAssets)
+{
+	FRandomStream RandomStream(Seed);
+
+	// Full tree of FolderDepth levels, cut short once there would be more leaves than assets
+	TArray<FString> LeafFolderPaths;
+	LeafFolderPaths.Add(RootPath);
+
+	for (int32 Depth = 0; Depth < FolderDepth && LeafFolderPaths.Num() * FolderFanout <= NumAssets; ++Depth)
+	{
+		TArray<FString> NextLevelFolderPaths;
+		NextLevelFolderPaths.Reserve(LeafFolderPaths.Num() * FolderFanout);
+
+		for (const FString& FolderPath : LeafFolderPaths)
+		{
+			for (int32 FolderIndex = 0; FolderIndex < FolderFanout; ++FolderIndex)
+			{
+				NextLevelFolderPaths.Add(FString::Printf(TEXT("%s/Folder_%d"), *FolderPath, FolderIndex));
+			}
+		}
+
+		LeafFolderPaths = MoveTemp(NextLevelFolderPaths);
+	}
+
+	FSavePackageArgs SaveArgs;
+	SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+	SaveArgs.SaveFlags = SAVE_NoError;
+	SaveArgs.Error = GWarn;
+
+	TArray<USuperManagerBenchmarkAsset*> GeneratedAssets;
+	GeneratedAssets.Reserve(NumAssets);
+
+	bool bSavedAll = true;
+	for (int32 AssetIndex = 0; AssetIndex < NumAssets; ++AssetIndex)
+	{
+		// Round robin over the leaves, so a reused name always lands in a different folder
+		const FString& FolderPath = LeafFolderPaths[AssetIndex % LeafFolderPaths.Num()];
+		const bool bReuseName = LeafFolderPaths.Num() > 1 && AssetIndex % SameNameInterval == SameNameInterval - 1;
+		const int32 NameIndex = bReuseName ? AssetIndex - 1 : AssetIndex;
+		const FString AssetName = FString::Printf(TEXT("BM_Asset_%d"), NameIndex);
+		const FString PackageName = FolderPath / AssetName;
+
+		UPackage* Package = CreatePackage(*PackageName);
+		USuperManagerBenchmarkAsset* Asset = NewObject<USuperManagerBenchmarkAsset>(Package, *AssetName, RF_Public | RF_Standalone);
+
+		// Only earlier assets are referenced, they are already saved and the graph stays acyclic
+		const int32 NumReferences = FMath::FloorToInt(ReferenceDensity) + (RandomStream.FRand() < FMath::Frac(ReferenceDensity) ? 1 : 0);
+		for (int32 ReferenceIndex = 0; ReferenceIndex < NumReferences && AssetIndex > 0; ++ReferenceIndex)
+		{
+			Asset->References.AddUnique(GeneratedAssets[RandomStream.RandHelper(AssetIndex)]);
+		}
+		GeneratedAssets.Add(Asset);
+
+		const FString PackageFilename = FPackageName::LongPackageNameToFilename(PackageName, FPackageName::GetAssetPackageExtension());
+		if (!UPackage::SavePackage(Package, Asset, *PackageFilename, SaveArgs))
+		{
+			UE_LOG(LogSuperManagerBenchmark, Error, TEXT("Failed to save %s"), *PackageFilename);
+			bSavedAll = false;
+			break;
+		}
+	}
+
+	// Everything is on disk, the phases only go through the registry and must not be measured with the generated objects loaded
+	for (USuperManagerBenchmarkAsset* Asset : GeneratedAssets)
+	{
+		Asset->ClearFlags(RF_Standalone);
+	}
+	GeneratedAssets.Empty();
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	if (!bSavedAll)
+	{
+		return false;
+	}
+
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	// Two levels deep, so the empty folder search has to look past the first one
+	const int32 NumEmptyFolders = FMath::RoundToInt(LeafFolderPaths.Num() * EmptyFolderRatio);
+	for (int32 EmptyFolderIndex = 0; EmptyFolderIndex < NumEmptyFolders; ++EmptyFolderIndex)
+	{
+		const FString EmptyFolderPath = FString::Printf(TEXT("%s/Empty_%d/Nested"), *LeafFolderPaths[EmptyFolderIndex % LeafFolderPaths.Num()], EmptyFolderIndex);
+
+		FString EmptyFolderFilename;
+		if (FPackageName::TryConvertLongPackageNameToFilename(EmptyFolderPath, EmptyFolderFilename))
+		{
+			IFileManager::Get().MakeDirectory(*EmptyFolderFilename, true);
+		}
+		AssetRegistry.AddPath(EmptyFolderPath);
+	}
+
+	AssetRegistry.ScanPathsSynchronous({ RootPath }, true);
+
+	UE_LOG(LogSuperManagerBenchmark, Display, TEXT("Generated %d assets in %d folders, %d empty folders"), NumAssets, LeafFolderPaths.Num(), NumEmptyFolders);
+	return true;
+}
+
+void USuperManagerBenchmarkCommandlet::DestroyContent(const FString& RootPath)
+{
+	// Resolve the filename first, dismounting drops every asset under the mount point from the registry
+	FString RootFilename;
+	const bool bHasRootFilename = FPackageName::TryConvertLongPackageNameToFilename(RootPath, RootFilename);
+
+	FPackageName::UnRegisterMountPoint(BenchmarkMountPoint, MountContentDir);
+
+	if (bHasRootFilename)
+	{
+		IFileManager::Get().DeleteDirectory(*RootFilename, false, true);
+	}
+}
+
+void USuperManagerBenchmarkCommandlet::RunBenchmark(const FString& RootPath, int32 NumAssets)
+{
+	TArray<FAssetData> AssetsData;
+	RunPhase(TEXT("gather"), NumAssets, [&RootPath, &AssetsData](int32& OutNumFound)
+	{
+		FContentAnalysis::GatherAssetsUnderFolder(RootPath, AssetsData);
+		OutNumFound = AssetsData.Num();
+	});
+
+	if (AssetsData.Num() != NumAssets)
+	{
+		UE_LOG(LogSuperManagerBenchmark, Warning, TEXT("Gathered %d assets under %s, expected %d"), AssetsData.Num(), *RootPath, NumAssets);
+	}
+
+	if (ShouldRunPhase(TEXT("listmodel")))
+	{
+		// What the Advanced Deletion tab builds before it can show anything
+		RunPhase(TEXT("listmodel"), NumAssets, [&AssetsData](int32& OutNumFound)
+		{
+			FAssetListModel AssetListModel;
+			AssetListModel.Reserve(AssetsData.Num());
+
+			for (const FAssetData& AssetData : AssetsData)
+			{
+				AssetListModel.Add(AssetData);
+			}
+			OutNumFound = AssetListModel.Num();
+		});
+	}
+
+	// The index covers the whole registry, only the temp mount and whatever the engine scanned on startup
+	FAssetReferenceIndex ReferenceIndex;
+	if (ShouldRunPhase(TEXT("referenceindex")) || ShouldRunPhase(TEXT("unused")))
+	{
+		RunPhase(TEXT("referenceindex"), NumAssets, [&ReferenceIndex](int32& OutNumFound)
+		{
+			ReferenceIndex.Build();
+			OutNumFound = ReferenceIndex.Num();
+		});
+	}
+
+	if (ShouldRunPhase(TEXT("unused")))
+	{
+		RunPhase(TEXT("unused"), NumAssets, [&AssetsData, &ReferenceIndex](int32& OutNumFound)
+		{
+			TArray<FAssetData> UnusedAssetsData;
+			FContentAnalysis::FindUnusedAssets(AssetsData, ReferenceIndex, UnusedAssetsData);
+			OutNumFound = UnusedAssetsData.Num();
+		});
+	}
+
+	if (ShouldRunPhase(TEXT("unusedparallel")))
+	{
+		TArray<FName> PackageNames;
+		PackageNames.Reserve(AssetsData.Num());
+
+		for (const FAssetData& AssetData : AssetsData)
+		{
+			PackageNames.Add(AssetData.PackageName);
+		}
+
+		// Same path as a scan started before the index is built
+		RunPhase(TEXT("unusedparallel"), NumAssets, [&PackageNames](int32& OutNumFound)
+		{
+			TArray<bool> IsUnused;
+			FContentAnalysis::QueryUnusedPackagesInParallel(PackageNames, IsUnused);
+			OutNumFound = Algo::Count(IsUnused, true);
+		});
+	}
+
+	if (ShouldRunPhase(TEXT("samename")))
+	{
+		RunPhase(TEXT("samename"), NumAssets, [&AssetsData](int32& OutNumFound)
+		{
+			TArray<FAssetData> SameNameAssetsData;
+			FContentAnalysis::FindSameNameAssets(AssetsData, SameNameAssetsData);
+			OutNumFound = SameNameAssetsData.Num();
+		});
+	}
+
+	TArray<FString> EmptyFolderPaths;
+	if (ShouldRunPhase(TEXT("emptyfolders")) || ShouldRunPhase(TEXT("deletefolders")))
+	{
+		RunPhase(TEXT("emptyfolders"), NumAssets, [&RootPath, &EmptyFolderPaths](int32& OutNumFound)
+		{
+			TArray<FString> RootPathArray;
+			RootPathArray.Add(RootPath);
+
+			EmptyFolderPaths.Reset();
+			FContentAnalysis::FindEmptyFolders(RootPathArray, EmptyFolderPaths);
+			OutNumFound = EmptyFolderPaths.Num();
+		});
+	}
+
+	// Last, it changes the content the other phases look at
+	if (ShouldRunPhase(TEXT("deletefolders")) && EmptyFolderPaths.Num() > 0)
+	{
+		RunPhase(TEXT("deletefolders"), EmptyFolderPaths.Num(), [&EmptyFolderPaths](int32& OutNumFound)
+		{
+			TArray<FString> DeletedFolderPaths;
+			FContentAnalysis::DeleteEmptyFolders(EmptyFolderPaths, DeletedFolderPaths);
+			OutNumFound = DeletedFolderPaths.Num();
+		});
+	}
+}
+
+void USuperManagerBenchmarkCommandlet::RunPhase(const FString& PhaseName, int32 NumAssets, TFunctionRef<void(int32& OutNumFound)> PhaseBody)
+{
+	int32 NumFound = 0;
+
+	const FPlatformMemoryStats MemoryStatsBefore = FPlatformMemory::GetStats();
+	const double PhaseStartTime = FPlatformTime::Seconds();
+	PhaseBody(NumFound);
+	const double PhaseSeconds = FPlatformTime::Seconds() - PhaseStartTime;
+	const FPlatformMemoryStats MemoryStatsAfter = FPlatformMemory::GetStats();
+
+	const double NanosecondsPerAsset = NumAssets > 0 ? PhaseSeconds * 1.0e9 / NumAssets : 0.0;
+	const int64 UsedPhysicalDelta = static_cast<int64>(MemoryStatsAfter.UsedPhysical) - static_cast<int64>(MemoryStatsBefore.UsedPhysical);
+
+	TSharedRef<FJsonObject> PhaseObject = MakeShared<FJsonObject>();
+	PhaseObject->SetStringField(TEXT("name"), PhaseName);
+	PhaseObject->SetNumberField(TEXT("seconds"), PhaseSeconds);
+	PhaseObject->SetNumberField(TEXT("found"), NumFound);
+	PhaseObject->SetNumberField(TEXT("nsPerAsset"), NanosecondsPerAsset);
+	PhaseObject->SetNumberField(TEXT("usedPhysicalDeltaBytes"), static_cast<double>(UsedPhysicalDelta));
+	PhaseObject->SetNumberField(TEXT("peakUsedPhysicalBytes"), static_cast<double>(MemoryStatsAfter.PeakUsedPhysical));
+	PhaseReports.Add(MakeShared<FJsonValueObject>(PhaseObject));
+
+	UE_LOG(LogSuperManagerBenchmark, Display, TEXT("%-16s %8.3fs  %10.1f ns/asset  found %8d  delta %+8.1f MiB  peak %8.1f MiB"),
+		*PhaseName, PhaseSeconds, NanosecondsPerAsset, NumFound, UsedPhysicalDelta / (1024.0 * 1024.0), MemoryStatsAfter.PeakUsedPhysical / (1024.0 * 1024.0));
+}
+
+bool USuperManagerBenchmarkCommandlet::ShouldRunPhase(const FString& PhaseName) const
+{
+	return PhasesToRun.Num() == 0 || PhasesToRun.Contains(PhaseName);
+}
@@ -0,0 +1,26 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Settings/SuperManagerSettings.h"
+#include "AssetAnalysis/PathExclusionRules.h"
+
+USuperManagerSettings::USuperManagerSettings()
+	: bTreatDirectoriesToAlwaysCookAsRoots(true)
+	, bTreatPrimaryAssetsAsRoots(true)
+	, RedirectorFixupBatchSize(256)
+	, RedirectorFixupMemoryBudgetMB(2048)
+	, FastDeletionChunkSize(512)
+{
+	ExcludedFolderNames.Add(FName("Developers"));
+	ExcludedFolderNames.Add(FName("Collections"));
+	ExcludedFolderNames.Add(FName("__ExternalActors__"));
+	ExcludedFolderNames.Add(FName("__ExternalObjects__"));
+}
+
+#if WITH_EDITOR
+void USuperManagerSettings::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	FPathExclusionRules::Recompile();
+}
+#endif
@@ -1,23 +1,84 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "SlateWidgets/AdvancedDeletionWidget.h"
-#include "Widgets/Layout/SScrollBox.h"
+#include "Widgets/Notifications/SProgressBar.h"
+#include "Widgets/Input/SSearchBox.h"
+#include "Widgets/Input/SEditableTextBox.h"
+#include "Widgets/Layout/SWrapBox.h"
 #include "SuperManagerModule.h"
+#include "AssetAnalysis/UnusedAssetsScanner.h"
+#include "AssetAnalysis/UnusedAssetsTracker.h"
+#include "AssetAnalysis/AssetReferenceIndex.h"
+#include "AssetAnalysis/PathExclusionRules.h"
+#include "AssetRegistryModule.h"
+#include "String/Find.h"
 #include "DebugHeader.h"
 
 #define LIST_ALL TEXT("List all available assets")
 #define LIST_UNUSED TEXT("List all unused assets")
 #define LIST_SAME_NAME TEXT("List all assets with the same name")
+#define LIST_UNREACHABLE TEXT("List all unreachable assets")
+
+namespace
+{
+	const FName SelectedColumnId(TEXT("Selected"));
+	const FName ClassColumnId(TEXT("Class"));
+	const FName NameColumnId(TEXT("Name"));
+	const FName PathColumnId(TEXT("Path"));
+	const FName DiskSizeColumnId(TEXT("DiskSize"));
+	const FName ReferencersColumnId(TEXT("Referencers"));
+	const FName ActionsColumnId(TEXT("Actions"));
+}
+
+void SAdvancedDeletionRow::Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	AssetItem = InArgs._AssetItem;
+	OwnerTab = InArgs._OwnerTab;
+
+	FSuperRowType::Construct(FSuperRowType::FArguments().Padding(FMargin(2.0f)), OwnerTable);
+}
+
+TSharedRef<SWidget> SAdvancedDeletionRow::GenerateWidgetForColumn(const FName& ColumnName)
+{
+	TSharedPtr<SAdvancedDeletionTab> PinnedOwnerTab = OwnerTab.Pin();
+	if (!PinnedOwnerTab.IsValid() || !AssetItem.IsValid())
+	{
+		return SNullWidget::NullWidget;
+	}
+
+	return PinnedOwnerTab->ConstructCellForColumn(AssetItem, ColumnName);
+}
 
 void SAdvancedDeletionTab::Construct(const FArguments& InArgs)
 {
 	bCanSupportFocus = true;
 
-	StoredAssetsDataArray = InArgs._AssetsDataToStoreArray;
-	DisplayedAssetsDataArray = InArgs._AssetsDataToStoreArray;
+	AssetListModel = InArgs._AssetListModel.IsValid() ? InArgs._AssetListModel : MakeShared<FAssetListModel>();
+
+	SelectedFolders = InArgs._SelectedFolders;
+	for (FString& SelectedFolder : SelectedFolders)
+	{
+		if (!SelectedFolder.EndsWith(TEXT("/")))
+		{
+			SelectedFolder.AppendChar(TEXT('/'));
+		}
+	}
+
+	// One item per row, the asset data itself stays in the model columns
+	StoredAssetItemsArray.Reserve(AssetListModel->Num());
+	for (int32 AssetIndex = 0; AssetIndex < AssetListModel->Num(); ++AssetIndex)
+	{
+		StoredAssetItemsArray.Add(AssetListModel->GetItem(AssetIndex));
+	}
 
-	AssetsDataToDeleteArray.Empty();
-	CheckBoxesArray.Empty();
+	ListedAssetItemsArray = StoredAssetItemsArray;
+
+	AssetListModel->ClearSelection();
+
+	// Fills in the referencer column when the index is already built, otherwise OnReferenceIndexReady does
+	UpdateReferencerCounts();
+
+	ApplySearch(false);
 
 	FSlateFontInfo TitleTextFont = FCoreStyle::Get().GetFontStyle(FName("EmbossedText"));
 	TitleTextFont.Size = 30;
@@ -26,6 +87,13 @@ void SAdvancedDeletionTab::Construct(const FArguments& InArgs)
 	ComboBoxSourceItems.Add(MakeShared<FString>(LIST_ALL));
 	ComboBoxSourceItems.Add(MakeShared<FString>(LIST_UNUSED));
 	ComboBoxSourceItems.Add(MakeShared<FString>(LIST_SAME_NAME));
+	ComboBoxSourceItems.Add(MakeShared<FString>(LIST_UNREACHABLE));
+
+	CurrentListingCondition = LIST_ALL;
+
+	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+	SuperManagerModule.GetUnusedAssetsTracker().OnUnusedAssetsChanged().AddSP(this, &SAdvancedDeletionTab::OnUnusedAssetsChanged);
+	SuperManagerModule.GetUnusedAssetsTracker().OnReferenceIndexReady().AddSP(this, &SAdvancedDeletionTab::OnReferenceIndexReady);
 
 	ChildSlot
 	[
@@ -67,28 +135,51 @@ void SAdvancedDeletionTab::Construct(const FArguments& InArgs)
 			+SHorizontalBox::Slot()
 			.FillWidth(0.1f)
 			[
-				ConstructComboBoxHelpText(TEXT("Current folder:\n") + InArgs._CurrentSelectedFolder, ETextJustify::Right)
+				ConstructComboBoxHelpText(TEXT("Current folders:\n") + FString::Join(InArgs._SelectedFolders, TEXT("\n")), ETextJustify::Right)
 			]
 		]
 
-		// 3rd Slot for the asset list
+		// Slot for the search box and the class facets
+		+SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(5.0f)
+		[
+			ConstructSearchBox()
+		]
+
+		// Slot for the progress of a running unused assets scan
+		+SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(5.0f)
+		[
+			ConstructScanProgressBox()
+		]
+
+		// 3rd Slot for the asset list, it gets the remaining height so only the visible rows are ever built
 		+ SVerticalBox::Slot()
 		.VAlign(EVerticalAlignment::VAlign_Fill)
 		[
-			SNew(SScrollBox)
-
-			+ SScrollBox::Slot()
-			[
-				ConstructAssetListView()
-			]
+			ConstructAssetListView()
 		]
 
-		// 4th Slot for 3 buttons
+		// 4th Slot for 4 buttons
 		+SVerticalBox::Slot()
 		.AutoHeight()
 		[
 			SNew(SHorizontalBox)
 
+			// Selected assets the bulk actions skip
+			+SHorizontalBox::Slot()
+			.AutoWidth()
+			.VAlign(VAlign_Center)
+			.Padding(5.0f)
+			[
+				SNew(STextBlock)
+				.Text(this, &SAdvancedDeletionTab::GetHiddenSelectionText)
+				.Visibility(this, &SAdvancedDeletionTab::GetHiddenSelectionVisibility)
+				.ColorAndOpacity(FColor::Yellow)
+			]
+
 			// Button 1: Delete All
 			+SHorizontalBox::Slot()
 			.FillWidth(10.0f)
@@ -97,7 +188,15 @@ void SAdvancedDeletionTab::Construct(const FArguments& InArgs)
 				ConstructDeleteAllButton()
 			]
 
-			// Button 2: Select All
+			// Button 2: Dry Run
+			+SHorizontalBox::Slot()
+			.FillWidth(10.0f)
+			.Padding(5.0f)
+			[
+				ConstructDryRunButton()
+			]
+
+			// Button 3: Select All
 			+SHorizontalBox::Slot()
 			.FillWidth(10.0f)
 			.Padding(5.0f)
@@ -105,7 +204,7 @@ void SAdvancedDeletionTab::Construct(const FArguments& InArgs)
 				ConstructSelectAllButton()
 			]
 
-			// Button 3: Deselect All
+			// Button 4: Deselect All
 			+SHorizontalBox::Slot()
 			.FillWidth(10.0f)
 			.Padding(5.0f)
@@ -114,26 +213,93 @@ void SAdvancedDeletionTab::Construct(const FArguments& InArgs)
 			]
 		]
 	];
+
+	RebuildClassFacets();
+}
+
+SAdvancedDeletionTab::~SAdvancedDeletionTab()
+{
+	CancelUnusedAssetsScan();
+
+	if (FSuperManagerModule* SuperManagerModule = FModuleManager::GetModulePtr<FSuperManagerModule>(TEXT("SuperManager")))
+	{
+		SuperManagerModule->GetUnusedAssetsTracker().OnUnusedAssetsChanged().RemoveAll(this);
+		SuperManagerModule->GetUnusedAssetsTracker().OnReferenceIndexReady().RemoveAll(this);
+	}
 }
 
-TSharedRef<SListView<TSharedPtr<FAssetData>>> SAdvancedDeletionTab::ConstructAssetListView()
+TSharedRef<SListView<TSharedPtr<FAssetListItem>>> SAdvancedDeletionTab::ConstructAssetListView()
 {
 	ConstructedAssetListView =
-		SNew(SListView<TSharedPtr<FAssetData>>)
+		SNew(SListView<TSharedPtr<FAssetListItem>>)
 		.ItemHeight(24.0f)
-		.ListItemsSource(&DisplayedAssetsDataArray)
+		.ListItemsSource(&DisplayedAssetItemsArray)
 		.OnGenerateRow(this, &SAdvancedDeletionTab::OnGenerateRowForList)
-		.OnMouseButtonClick(this, &SAdvancedDeletionTab::OnRowWidgetMouseButtonClicked);
+		.OnMouseButtonClick(this, &SAdvancedDeletionTab::OnRowWidgetMouseButtonClicked)
+		.HeaderRow(ConstructHeaderRow());
 
 	return ConstructedAssetListView.ToSharedRef();
 }
 
-TSharedRef<ITableRow> SAdvancedDeletionTab::OnGenerateRowForList(TSharedPtr<FAssetData> AssetDataToDisplay, const TSharedRef<STableViewBase>& OwnerTable)
+TSharedRef<SHeaderRow> SAdvancedDeletionTab::ConstructHeaderRow()
 {
-	if (!AssetDataToDisplay.IsValid())
-	{
-		return SNew(STableRow<TSharedPtr<FAssetData>>, OwnerTable);
-	}
+	TSharedRef<SHeaderRow> ConstructedHeaderRow =
+		SNew(SHeaderRow)
+
+		+SHeaderRow::Column(SelectedColumnId)
+		.DefaultLabel(FText::GetEmpty())
+		.FixedWidth(30.0f)
+
+		+SHeaderRow::Column(ClassColumnId)
+		.DefaultLabel(FText::FromString(TEXT("Class")))
+		.FillWidth(0.15f)
+		.SortMode(this, &SAdvancedDeletionTab::GetColumnSortMode, ClassColumnId)
+		.OnSort(this, &SAdvancedDeletionTab::OnColumnSortModeChanged)
+
+		+SHeaderRow::Column(NameColumnId)
+		.DefaultLabel(FText::FromString(TEXT("Name")))
+		.FillWidth(0.3f)
+		.SortMode(this, &SAdvancedDeletionTab::GetColumnSortMode, NameColumnId)
+		.OnSort(this, &SAdvancedDeletionTab::OnColumnSortModeChanged)
+
+		+SHeaderRow::Column(PathColumnId)
+		.DefaultLabel(FText::FromString(TEXT("Path")))
+		.FillWidth(0.35f)
+		.SortMode(this, &SAdvancedDeletionTab::GetColumnSortMode, PathColumnId)
+		.OnSort(this, &SAdvancedDeletionTab::OnColumnSortModeChanged)
+
+		+SHeaderRow::Column(DiskSizeColumnId)
+		.DefaultLabel(FText::FromString(TEXT("Disk Size")))
+		.FillWidth(0.1f)
+		.HAlignCell(EHorizontalAlignment::HAlign_Right)
+		.SortMode(this, &SAdvancedDeletionTab::GetColumnSortMode, DiskSizeColumnId)
+		.OnSort(this, &SAdvancedDeletionTab::OnColumnSortModeChanged)
+
+		+SHeaderRow::Column(ReferencersColumnId)
+		.DefaultLabel(FText::FromString(TEXT("Referencers")))
+		.FillWidth(0.1f)
+		.HAlignCell(EHorizontalAlignment::HAlign_Right)
+		.SortMode(this, &SAdvancedDeletionTab::GetColumnSortMode, ReferencersColumnId)
+		.OnSort(this, &SAdvancedDeletionTab::OnColumnSortModeChanged)
+
+		+SHeaderRow::Column(ActionsColumnId)
+		.DefaultLabel(FText::GetEmpty())
+		.FixedWidth(80.0f);
+
+	return ConstructedHeaderRow;
+}
+
+TSharedRef<ITableRow> SAdvancedDeletionTab::OnGenerateRowForList(TSharedPtr<FAssetListItem> AssetItemToDisplay, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	// Called for visible rows only, scrolling recycles them
+	return SNew(SAdvancedDeletionRow, OwnerTable)
+		.AssetItem(AssetItemToDisplay)
+		.OwnerTab(SharedThis(this));
+}
+
+TSharedRef<SWidget> SAdvancedDeletionTab::ConstructCellForColumn(const TSharedPtr<FAssetListItem>& AssetItemToDisplay, const FName& ColumnName)
+{
+	const int32 AssetIndex = AssetItemToDisplay->Index;
 
 	FSlateFontInfo AssetClassNameTextFont = FCoreStyle::Get().GetFontStyle(FName("EmbossedText"));
 	AssetClassNameTextFont.Size = 10;
@@ -141,94 +307,563 @@ TSharedRef<ITableRow> SAdvancedDeletionTab::OnGenerateRowForList(TSharedPtr<FAss
 	FSlateFontInfo AssetNameTextFont = FCoreStyle::Get().GetFontStyle(FName("EmbossedText"));
 	AssetNameTextFont.Size = 15;
 
-	TSharedRef<STableRow<TSharedPtr<FAssetData>>> ListViewRowWidget =
-	SNew(STableRow<TSharedPtr<FAssetData>>, OwnerTable)
-	.Padding(FMargin(5.0f))
-	[
-		SNew(SHorizontalBox)
+	if (ColumnName == SelectedColumnId)
+	{
+		return ConstructCheckBox(AssetItemToDisplay);
+	}
 
-		// 1st Slot for check box
-		+SHorizontalBox::Slot()
-		.HAlign(EHorizontalAlignment::HAlign_Left)
-		.VAlign(EVerticalAlignment::VAlign_Center)
-		.FillWidth(0.05f)
-		[
-			ConstructCheckBox(AssetDataToDisplay)
-		]
+	if (ColumnName == ClassColumnId)
+	{
+		return ConstructTextForRowWidget(AssetListModel->GetAssetClass(AssetIndex).ToString(), AssetClassNameTextFont);
+	}
 
-		// 2nd Slot for displaying asset class name
-		+SHorizontalBox::Slot()
-		.HAlign(EHorizontalAlignment::HAlign_Center)
-		.VAlign(EVerticalAlignment::VAlign_Fill)
-		.FillWidth(0.5f)
+	if (ColumnName == NameColumnId)
+	{
+		return ConstructTextForRowWidget(AssetListModel->GetAssetName(AssetIndex).ToString(), AssetNameTextFont);
+	}
+
+	if (ColumnName == PathColumnId)
+	{
+		return ConstructTextForRowWidget(AssetListModel->GetPackagePath(AssetIndex).ToString(), AssetClassNameTextFont);
+	}
+
+	if (ColumnName == DiskSizeColumnId)
+	{
+		return ConstructTextForRowWidget(FText::AsMemory(AssetListModel->ReadDiskSize(AssetIndex)).ToString(), AssetClassNameTextFont);
+	}
+
+	if (ColumnName == ReferencersColumnId)
+	{
+		// Bound, the counts change whenever the reference index is updated
+		return SNew(STextBlock)
+			.Font(AssetClassNameTextFont)
+			.ColorAndOpacity(FColor::White)
+			.Text_Lambda([this, AssetIndex]()
+			{
+				const int32 ReferencerCount = AssetListModel->GetReferencerCount(AssetIndex);
+				return ReferencerCount != INDEX_NONE ? FText::AsNumber(ReferencerCount) : FText::FromString(TEXT("-"));
+			});
+	}
+
+	if (ColumnName == ActionsColumnId)
+	{
+		return ConstructButtonForRowWidget(AssetItemToDisplay);
+	}
+
+	return SNullWidget::NullWidget;
+}
+
+void SAdvancedDeletionTab::OnRowWidgetMouseButtonClicked(TSharedPtr<FAssetListItem> ClickedItem)
+{
+	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+	SuperManagerModule.SyncContentBrowserToClickedAssetForAssetList(AssetListModel->GetObjectPath(ClickedItem->Index));
+}
+
+void SAdvancedDeletionTab::RefreshAssetListView()
+{
+	AssetListModel->ClearSelection();
+
+	SortListedAssetItems();
+	ApplySearch(false);
+
+	if (ConstructedAssetListView.IsValid())
+	{
+		ConstructedAssetListView->RebuildList();
+	}
+}
+
+void SAdvancedDeletionTab::CompactRemovedAssetItems()
+{
+	auto IsRemovedAssetItem = [this](const TSharedPtr<FAssetListItem>& AssetItem)
+	{
+		return AssetListModel->IsRemoved(AssetItem->Index);
+	};
+
+	// RemoveAll keeps the order, the sort stays valid
+	StoredAssetItemsArray.RemoveAll(IsRemovedAssetItem);
+	RemoveListedAssetItems(IsRemovedAssetItem);
+
+	// Existing rows are reused, only the ones for removed items go away
+	if (ConstructedAssetListView.IsValid())
+	{
+		ConstructedAssetListView->RequestListRefresh();
+	}
+}
+
+EColumnSortMode::Type SAdvancedDeletionTab::GetColumnSortMode(FName ColumnId) const
+{
+	return ColumnId == SortColumnId ? SortMode : EColumnSortMode::None;
+}
+
+void SAdvancedDeletionTab::OnColumnSortModeChanged(EColumnSortPriority::Type SortPriority, const FName& ColumnId, EColumnSortMode::Type NewSortMode)
+{
+	SortColumnId = ColumnId;
+	SortMode = NewSortMode;
+
+	// Never waits for the index, the known counts are sorted now and the list is sorted again once it is ready
+	if (SortColumnId == ReferencersColumnId && !AssetListModel->HasReferencerCounts())
+	{
+		UpdateReferencerCounts();
+
+		if (!AssetListModel->HasReferencerCounts())
+		{
+			DebugHeader::ShowNotifyInfo(TEXT("Asset references are still being indexed, the list will be sorted again when it finishes"));
+		}
+	}
+
+	SortListedAssetItems();
+	ApplySearch(false);
+
+	if (ConstructedAssetListView.IsValid())
+	{
+		ConstructedAssetListView->RequestListRefresh();
+	}
+}
+
+void SAdvancedDeletionTab::SortListedAssetItems()
+{
+	if (SortMode == EColumnSortMode::None || SortColumnId.IsNone())
+	{
+		return;
+	}
+
+	// Sizes are read before sorting, the comparison itself only reads the model
+	if (SortColumnId == DiskSizeColumnId)
+	{
+		for (const TSharedPtr<FAssetListItem>& ListedAssetItem : ListedAssetItemsArray)
+		{
+			AssetListModel->ReadDiskSize(ListedAssetItem->Index);
+		}
+	}
+
+	const FAssetListModel& Model = *AssetListModel;
+
+	// Three way comparison on the model columns, the row handles themselves are never touched
+	TFunction<int32(int32, int32)> CompareRows;
+	if (SortColumnId == ClassColumnId)
+	{
+		CompareRows = [&Model](int32 A, int32 B) { return Model.GetAssetClass(A).Compare(Model.GetAssetClass(B)); };
+	}
+	else if (SortColumnId == NameColumnId)
+	{
+		CompareRows = [&Model](int32 A, int32 B) { return Model.GetAssetName(A).Compare(Model.GetAssetName(B)); };
+	}
+	else if (SortColumnId == PathColumnId)
+	{
+		CompareRows = [&Model](int32 A, int32 B)
+		{
+			const int32 PathComparison = Model.GetPackagePath(A).Compare(Model.GetPackagePath(B));
+			return PathComparison != 0 ? PathComparison : Model.GetAssetName(A).Compare(Model.GetAssetName(B));
+		};
+	}
+	else if (SortColumnId == DiskSizeColumnId)
+	{
+		CompareRows = [&Model](int32 A, int32 B) { return (Model.GetDiskSize(A) > Model.GetDiskSize(B)) - (Model.GetDiskSize(A) < Model.GetDiskSize(B)); };
+	}
+	else if (SortColumnId == ReferencersColumnId)
+	{
+		CompareRows = [&Model](int32 A, int32 B) { return Model.GetReferencerCount(A) - Model.GetReferencerCount(B); };
+	}
+	else
+	{
+		return;
+	}
+
+	const bool bIsAscending = SortMode == EColumnSortMode::Ascending;
+	ListedAssetItemsArray.StableSort([&CompareRows, bIsAscending](const TSharedPtr<FAssetListItem>& A, const TSharedPtr<FAssetListItem>& B)
+	{
+		const int32 Comparison = CompareRows(A->Index, B->Index);
+		return bIsAscending ? Comparison < 0 : Comparison > 0;
+	});
+}
+
+void SAdvancedDeletionTab::UpdateReferencerCounts()
+{
+	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+
+	TSharedPtr<FAssetReferenceIndex, ESPMode::ThreadSafe> ReferenceIndex = SuperManagerModule.GetAssetReferenceIndex();
+	if (ReferenceIndex.IsValid())
+	{
+		AssetListModel->UpdateReferencerCounts(*ReferenceIndex);
+	}
+}
+
+TSharedRef<SVerticalBox> SAdvancedDeletionTab::ConstructSearchBox()
+{
+	TSharedRef<SVerticalBox> ConstructedSearchBox =
+		SNew(SVerticalBox)
+
+		// Search box slot
+		+SVerticalBox::Slot()
+		.AutoHeight()
 		[
-			ConstructTextForRowWidget(AssetDataToDisplay->AssetClass.ToString(), AssetClassNameTextFont)
+			SNew(SSearchBox)
+			.HintText(FText::FromString(TEXT("Search asset names")))
+			.OnTextChanged(this, &SAdvancedDeletionTab::OnSearchTextChanged)
 		]
 
-		// 3rd Slot for displaying asset name
-		+ SHorizontalBox::Slot()
-		.HAlign(EHorizontalAlignment::HAlign_Left)
-		.VAlign(EVerticalAlignment::VAlign_Fill)
+		// Tag filter slot
+		+SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(FMargin(0.0f, 5.0f, 0.0f, 0.0f))
 		[
-			ConstructTextForRowWidget(AssetDataToDisplay->AssetName.ToString(), AssetNameTextFont)
+			SAssignNew(TagFilterTextBox, SEditableTextBox)
+			.HintText(FText::FromString(TEXT("Tag filter, e.g. Dimensions > 2048 OR Triangles > 100000 AND LODs < 2 (Enter to apply)")))
+			.OnTextCommitted(this, &SAdvancedDeletionTab::OnTagFilterTextCommitted)
 		]
 
-		// 4th Slot for a button
-		+ SHorizontalBox::Slot()
-		.HAlign(EHorizontalAlignment::HAlign_Right)
-		.VAlign(EVerticalAlignment::VAlign_Fill)
+		// Class facets slot
+		+SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(FMargin(0.0f, 5.0f, 0.0f, 0.0f))
 		[
-			ConstructButtonForRowWidget(AssetDataToDisplay)
-		]
-	];
+			SAssignNew(ClassFacetsBox, SWrapBox)
+			.UseAllottedSize(true)
+			.InnerSlotPadding(FVector2D(5.0f, 5.0f))
+		];
 
-	return ListViewRowWidget;
+	return ConstructedSearchBox;
 }
 
-void SAdvancedDeletionTab::OnRowWidgetMouseButtonClicked(TSharedPtr<FAssetData> ClickedData)
+void SAdvancedDeletionTab::OnSearchTextChanged(const FText& InSearchText)
 {
-	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
-	SuperManagerModule.SyncContentBrowserToClickedAssetForAssetList(ClickedData->ObjectPath.ToString());
+	const FString NewSearchText = InSearchText.ToString().ToLower();
+	if (NewSearchText == SearchText)
+	{
+		return;
+	}
+
+	// Typing on only ever drops matches, so the previous ones are all that need checking
+	const bool bNarrow = NewSearchText.StartsWith(SearchText, ESearchCase::CaseSensitive);
+
+	SearchText = NewSearchText;
+	SearchText.ParseIntoArrayWS(SearchTokens);
+
+	ApplySearch(bNarrow);
+
+	if (ConstructedAssetListView.IsValid())
+	{
+		ConstructedAssetListView->RequestListRefresh();
+	}
 }
 
-void SAdvancedDeletionTab::RefreshAssetListView()
+bool SAdvancedDeletionTab::DoesAssetItemMatchSearch(const TSharedPtr<FAssetListItem>& AssetItem) const
 {
-	AssetsDataToDeleteArray.Empty();
-	CheckBoxesArray.Empty();
+	if (!TagFilter.IsEmpty() && !(TagFilterMatches.IsValidIndex(AssetItem->Index) && TagFilterMatches[AssetItem->Index]))
+	{
+		return false;
+	}
+
+	if (SearchTokens.Num() == 0)
+	{
+		return true;
+	}
+
+	// Written out of the FName on the stack, the model keeps no string per row
+	TStringBuilder<256> AssetNameBuilder;
+	AssetListModel->GetAssetName(AssetItem->Index).AppendString(AssetNameBuilder);
+
+	for (const FString& SearchToken : SearchTokens)
+	{
+		if (UE::String::FindFirst(AssetNameBuilder.ToView(), SearchToken, ESearchCase::IgnoreCase) == INDEX_NONE)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void SAdvancedDeletionTab::OnTagFilterTextCommitted(const FText& InFilterText, ETextCommit::Type CommitType)
+{
+	if (CommitType == ETextCommit::OnCleared)
+	{
+		return;
+	}
+
+	FString ParseError;
+	if (!TagFilter.Parse(InFilterText.ToString(), ParseError))
+	{
+		TagFilterTextBox->SetError(FText::FromString(ParseError));
+		TagFilterMatches.Empty();
+	}
+	else
+	{
+		TagFilterTextBox->SetError(FText::GetEmpty());
+
+		// Tags are read from the registry, no package is loaded
+		const double EvaluationStartTime = FPlatformTime::Seconds();
+		TagFilter.Evaluate(*AssetListModel, TagFilterMatches);
+
+		if (!TagFilter.IsEmpty())
+		{
+			DebugHeader::PrintLog(FString::Printf(TEXT("Tag filter matched %d of %d assets in %.2f ms"),
+				TagFilterMatches.CountSetBits(), TagFilterMatches.Num(), (FPlatformTime::Seconds() - EvaluationStartTime) * 1000.0));
+		}
+	}
+
+	ApplySearch(false);
 
 	if (ConstructedAssetListView.IsValid())
 	{
-		ConstructedAssetListView->RebuildList();
+		ConstructedAssetListView->RequestListRefresh();
+	}
+}
+
+void SAdvancedDeletionTab::ApplySearch(bool bNarrow)
+{
+	const TArray<TSharedPtr<FAssetListItem>>& SourceAssetItems = bNarrow ? SearchMatchedAssetItemsArray : ListedAssetItemsArray;
+
+	TArray<TSharedPtr<FAssetListItem>> MatchedAssetItems;
+	MatchedAssetItems.Reserve(SourceAssetItems.Num());
+
+	TMap<FName, int32> NewClassHistogram;
+
+	for (const TSharedPtr<FAssetListItem>& AssetItem : SourceAssetItems)
+	{
+		if (DoesAssetItemMatchSearch(AssetItem))
+		{
+			MatchedAssetItems.Add(AssetItem);
+			++NewClassHistogram.FindOrAdd(AssetListModel->GetAssetClass(AssetItem->Index));
+		}
+	}
+
+	SearchMatchedAssetItemsArray = MoveTemp(MatchedAssetItems);
+
+	// The facets only need new widgets when a class appears or disappears, the counts are bound
+	bool bClassesChanged = NewClassHistogram.Num() != ClassHistogram.Num();
+	for (const TPair<FName, int32>& ClassCount : NewClassHistogram)
+	{
+		if (bClassesChanged)
+		{
+			break;
+		}
+
+		bClassesChanged = !ClassHistogram.Contains(ClassCount.Key);
+	}
+
+	ClassHistogram = MoveTemp(NewClassHistogram);
+
+	if (bClassesChanged)
+	{
+		RebuildClassFacets();
+	}
+
+	ApplyClassFacets();
+}
+
+void SAdvancedDeletionTab::ApplyClassFacets()
+{
+	NumSelectedAtHiddenCount = INDEX_NONE;
+
+	if (HiddenClasses.Num() == 0)
+	{
+		DisplayedAssetItemsArray = SearchMatchedAssetItemsArray;
+		return;
+	}
+
+	DisplayedAssetItemsArray.Reset(SearchMatchedAssetItemsArray.Num());
+
+	for (const TSharedPtr<FAssetListItem>& AssetItem : SearchMatchedAssetItemsArray)
+	{
+		if (!HiddenClasses.Contains(AssetListModel->GetAssetClass(AssetItem->Index)))
+		{
+			DisplayedAssetItemsArray.Add(AssetItem);
+		}
+	}
+}
+
+void SAdvancedDeletionTab::RebuildClassFacets()
+{
+	if (!ClassFacetsBox.IsValid())
+	{
+		return;
+	}
+
+	ClassFacetsBox->ClearChildren();
+
+	// Most common classes first
+	TArray<FName> AssetClasses;
+	ClassHistogram.GenerateKeyArray(AssetClasses);
+	AssetClasses.Sort([this](const FName A, const FName B)
+	{
+		const int32 CountA = ClassHistogram.FindChecked(A);
+		const int32 CountB = ClassHistogram.FindChecked(B);
+		return CountA != CountB ? CountA > CountB : A.LexicalLess(B);
+	});
+
+	for (const FName AssetClass : AssetClasses)
+	{
+		ClassFacetsBox->AddSlot()
+		[
+			SNew(SCheckBox)
+			.Style(FCoreStyle::Get(), "ToggleButtonCheckbox")
+			.IsChecked(this, &SAdvancedDeletionTab::GetClassFacetState, AssetClass)
+			.OnCheckStateChanged(this, &SAdvancedDeletionTab::OnClassFacetStateChanged, AssetClass)
+			[
+				SNew(STextBlock)
+				.Margin(FMargin(5.0f, 2.0f))
+				.Text(this, &SAdvancedDeletionTab::GetClassFacetText, AssetClass)
+			]
+		];
+	}
+}
+
+ECheckBoxState SAdvancedDeletionTab::GetClassFacetState(FName AssetClass) const
+{
+	return HiddenClasses.Contains(AssetClass) ? ECheckBoxState::Unchecked : ECheckBoxState::Checked;
+}
+
+void SAdvancedDeletionTab::OnClassFacetStateChanged(ECheckBoxState NewState, FName AssetClass)
+{
+	if (NewState == ECheckBoxState::Checked)
+	{
+		HiddenClasses.Remove(AssetClass);
+	}
+	else
+	{
+		HiddenClasses.Add(AssetClass);
+	}
+
+	ApplyClassFacets();
+
+	if (ConstructedAssetListView.IsValid())
+	{
+		ConstructedAssetListView->RequestListRefresh();
+	}
+}
+
+FText SAdvancedDeletionTab::GetClassFacetText(FName AssetClass) const
+{
+	return FText::FromString(FString::Printf(TEXT("%s (%d)"), *AssetClass.ToString(), ClassHistogram.FindRef(AssetClass)));
+}
+
+void SAdvancedDeletionTab::AddListedAssetItem(const TSharedPtr<FAssetListItem>& AssetItem, bool& bOutClassesChanged)
+{
+	ListedAssetItemsArray.Add(AssetItem);
+	NumSelectedAtHiddenCount = INDEX_NONE;
+
+	// Same steps as ApplySearch, for the new row only
+	if (!DoesAssetItemMatchSearch(AssetItem))
+	{
+		return;
+	}
+
+	SearchMatchedAssetItemsArray.Add(AssetItem);
+
+	const FName AssetClass = AssetListModel->GetAssetClass(AssetItem->Index);
+	int32& ClassCount = ClassHistogram.FindOrAdd(AssetClass);
+	bOutClassesChanged |= ClassCount == 0;
+	++ClassCount;
+
+	if (!HiddenClasses.Contains(AssetClass))
+	{
+		DisplayedAssetItemsArray.Add(AssetItem);
+	}
+}
+
+int32 SAdvancedDeletionTab::RemoveListedAssetItems(TFunctionRef<bool(const TSharedPtr<FAssetListItem>&)> Predicate)
+{
+	const int32 NumRemoved = ListedAssetItemsArray.RemoveAll(Predicate);
+	if (NumRemoved == 0)
+	{
+		return 0;
+	}
+
+	NumSelectedAtHiddenCount = INDEX_NONE;
+
+	bool bClassesChanged = false;
+
+	SearchMatchedAssetItemsArray.RemoveAll([this, &Predicate, &bClassesChanged](const TSharedPtr<FAssetListItem>& AssetItem)
+	{
+		if (!Predicate(AssetItem))
+		{
+			return false;
+		}
+
+		const FName AssetClass = AssetListModel->GetAssetClass(AssetItem->Index);
+		if (--ClassHistogram.FindChecked(AssetClass) == 0)
+		{
+			ClassHistogram.Remove(AssetClass);
+			bClassesChanged = true;
+		}
+
+		return true;
+	});
+
+	DisplayedAssetItemsArray.RemoveAll(Predicate);
+
+	if (bClassesChanged)
+	{
+		RebuildClassFacets();
 	}
+
+	return NumRemoved;
 }
 
-TSharedRef<SCheckBox> SAdvancedDeletionTab::ConstructCheckBox(const TSharedPtr<FAssetData> AssetDataToDisplay)
+TSharedRef<SCheckBox> SAdvancedDeletionTab::ConstructCheckBox(const TSharedPtr<FAssetListItem> AssetItemToDisplay)
 {
+	// The check state lives in the tab, rows come and go while scrolling
 	TSharedRef<SCheckBox> ConstructedCheckBox =
 		SNew(SCheckBox)
 		.Type(ESlateCheckBoxType::CheckBox)
-		.OnCheckStateChanged(this, &SAdvancedDeletionTab::OnCheckBoxStateChanged, AssetDataToDisplay)
+		.IsChecked(this, &SAdvancedDeletionTab::GetCheckBoxState, AssetItemToDisplay)
+		.OnCheckStateChanged(this, &SAdvancedDeletionTab::OnCheckBoxStateChanged, AssetItemToDisplay)
 		.Visibility(EVisibility::Visible);
 
-	CheckBoxesArray.Add(ConstructedCheckBox);
 	return ConstructedCheckBox;
 }
 
-void SAdvancedDeletionTab::OnCheckBoxStateChanged(ECheckBoxState NewState, TSharedPtr<FAssetData> AssetData)
+ECheckBoxState SAdvancedDeletionTab::GetCheckBoxState(TSharedPtr<FAssetListItem> AssetItem) const
+{
+	return AssetListModel->IsSelected(AssetItem->Index) ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
+}
+
+void SAdvancedDeletionTab::OnCheckBoxStateChanged(ECheckBoxState NewState, TSharedPtr<FAssetListItem> AssetItem)
+{
+	AssetListModel->SetSelected(AssetItem->Index, NewState == ECheckBoxState::Checked);
+}
+
+void SAdvancedDeletionTab::GetSelectedAssetItems(TArray<TSharedPtr<FAssetListItem>>& OutSelectedItems) const
+{
+	OutSelectedItems.Reserve(OutSelectedItems.Num() + AssetListModel->GetNumSelected());
+
+	for (const TSharedPtr<FAssetListItem>& AssetItem : DisplayedAssetItemsArray)
+	{
+		if (AssetListModel->IsSelected(AssetItem->Index))
+		{
+			OutSelectedItems.Add(AssetItem);
+		}
+	}
+}
+
+int32 SAdvancedDeletionTab::GetNumHiddenSelected() const
 {
-	switch (NewState)
+	// Bound to the UI, so the displayed rows are only walked again once something changed
+	const int32 NumSelected = AssetListModel->GetNumSelected();
+	if (NumSelected != NumSelectedAtHiddenCount)
 	{
-	case ECheckBoxState::Unchecked:
-		if (AssetsDataToDeleteArray.Contains(AssetData))
+		int32 NumDisplayedSelected = 0;
+		for (const TSharedPtr<FAssetListItem>& AssetItem : DisplayedAssetItemsArray)
 		{
-			AssetsDataToDeleteArray.Remove(AssetData);
+			NumDisplayedSelected += AssetListModel->IsSelected(AssetItem->Index) ? 1 : 0;
 		}
-		break;
 
-	case ECheckBoxState::Checked:
-		AssetsDataToDeleteArray.AddUnique(AssetData);
-		break;
+		NumHiddenSelected = NumSelected - NumDisplayedSelected;
+		NumSelectedAtHiddenCount = NumSelected;
 	}
+
+	return NumHiddenSelected;
+}
+
+FText SAdvancedDeletionTab::GetHiddenSelectionText() const
+{
+	return FText::FromString(FString::Printf(TEXT("%d selected assets are hidden and won't be deleted"), GetNumHiddenSelected()));
+}
+
+EVisibility SAdvancedDeletionTab::GetHiddenSelectionVisibility() const
+{
+	return GetNumHiddenSelected() > 0 ? EVisibility::Visible : EVisibility::Collapsed;
 }
 
 TSharedRef<STextBlock> SAdvancedDeletionTab::ConstructTextForRowWidget(const FString& TextContent, const FSlateFontInfo& FontToUse)
@@ -242,37 +877,26 @@ TSharedRef<STextBlock> SAdvancedDeletionTab::ConstructTextForRowWidget(const FSt
 	return ConstructedTextBlock;
 }
 
-TSharedRef<SButton> SAdvancedDeletionTab::ConstructButtonForRowWidget(TSharedPtr<FAssetData> AssetDataToDisplay)
+TSharedRef<SButton> SAdvancedDeletionTab::ConstructButtonForRowWidget(TSharedPtr<FAssetListItem> AssetItemToDisplay)
 {
 	TSharedRef<SButton> ConstructedButton = 
 		SNew(SButton)
 		.Text(FText::FromString(TEXT("Delete")))
-		.OnClicked(this, &SAdvancedDeletionTab::OnDeleteButtonClicked, AssetDataToDisplay);
+		.OnClicked(this, &SAdvancedDeletionTab::OnDeleteButtonClicked, AssetItemToDisplay);
 
 	return ConstructedButton;
 }
 
-FReply SAdvancedDeletionTab::OnDeleteButtonClicked(TSharedPtr<FAssetData> ClickedAssetData)
+FReply SAdvancedDeletionTab::OnDeleteButtonClicked(TSharedPtr<FAssetListItem> ClickedAssetItem)
 {
 	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
-	bool bAssetDeleted = SuperManagerModule.DeleteSingleAssetForAssetList(*ClickedAssetData.Get());
+	bool bAssetDeleted = SuperManagerModule.DeleteSingleAssetForAssetList(AssetListModel->MakeAssetData(ClickedAssetItem->Index));
 
 	// Refresh the list
 	if (bAssetDeleted)
 	{
-		// Update the list source items
-		if (StoredAssetsDataArray.Contains(ClickedAssetData))
-		{
-			StoredAssetsDataArray.Remove(ClickedAssetData);
-		}
-
-		if (DisplayedAssetsDataArray.Contains(ClickedAssetData))
-		{
-			DisplayedAssetsDataArray.Remove(ClickedAssetData);
-		}
-
-		// Update the list
-		RefreshAssetListView();
+		AssetListModel->MarkRemoved(ClickedAssetItem->Index);
+		CompactRemovedAssetItems();
 	}
 
 	return FReply::Handled();
@@ -292,7 +916,11 @@ TSharedRef<SButton> SAdvancedDeletionTab::ConstructDeleteAllButton()
 
 FReply SAdvancedDeletionTab::OnDeleteAllButtonClicked()
 {
-	if (AssetsDataToDeleteArray.Num() == 0)
+	// Rows hidden by the search, the tag filter or the class facets stay selected but are left alone, the count next to the buttons shows them
+	TArray<TSharedPtr<FAssetListItem>> SelectedAssetItems;
+	GetSelectedAssetItems(SelectedAssetItems);
+
+	if (SelectedAssetItems.Num() == 0)
 	{
 		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("No assets currently selected"));
 		return FReply::Handled();
@@ -300,9 +928,11 @@ FReply SAdvancedDeletionTab::OnDeleteAllButtonClicked()
 
 	// Pass data to our module for deletion
 	TArray<FAssetData> AssetDataToDelete;
-	for (const TSharedPtr<FAssetData>& Data : AssetsDataToDeleteArray)
+	AssetDataToDelete.Reserve(SelectedAssetItems.Num());
+
+	for (const TSharedPtr<FAssetListItem>& AssetItem : SelectedAssetItems)
 	{
-		AssetDataToDelete.Add(*Data.Get());
+		AssetDataToDelete.Add(AssetListModel->MakeAssetData(AssetItem->Index));
 	}
 
 	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
@@ -310,22 +940,57 @@ FReply SAdvancedDeletionTab::OnDeleteAllButtonClicked()
 
 	if (bAssetsDeleted)
 	{
-		for (const TSharedPtr<FAssetData>& DeletedData : AssetsDataToDeleteArray)
-		{
-			if (StoredAssetsDataArray.Contains(DeletedData))
-			{
-				StoredAssetsDataArray.Remove(DeletedData);
-			}
+		IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
 
-			if (DisplayedAssetsDataArray.Contains(DeletedData))
+		// The delete dialog may have kept some of them, only the assets the registry dropped leave the list
+		for (const TSharedPtr<FAssetListItem>& SelectedItem : SelectedAssetItems)
+		{
+			if (!AssetRegistry.GetAssetByObjectPath(FName(*AssetListModel->GetObjectPath(SelectedItem->Index))).IsValid())
 			{
-				DisplayedAssetsDataArray.Remove(DeletedData);
+				AssetListModel->MarkRemoved(SelectedItem->Index);
 			}
 		}
 
-		RefreshAssetListView();
+		CompactRemovedAssetItems();
+	}
+
+	return FReply::Handled();
+}
+
+TSharedRef<SButton> SAdvancedDeletionTab::ConstructDryRunButton()
+{
+	TSharedRef<SButton> DryRunButton =
+		SNew(SButton)
+		.ContentPadding(FMargin(5.0f))
+		.OnClicked(this, &SAdvancedDeletionTab::OnDryRunButtonClicked);
+
+	DryRunButton->SetContent(ConstructTextBlockForTabButtons(TEXT("Dry Run")));
+
+	return DryRunButton;
+}
+
+FReply SAdvancedDeletionTab::OnDryRunButtonClicked()
+{
+	TArray<TSharedPtr<FAssetListItem>> SelectedAssetItems;
+	GetSelectedAssetItems(SelectedAssetItems);
+
+	if (SelectedAssetItems.Num() == 0)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("No assets currently selected"));
+		return FReply::Handled();
+	}
+
+	TArray<FAssetData> AssetDataToPlan;
+	AssetDataToPlan.Reserve(SelectedAssetItems.Num());
+
+	for (const TSharedPtr<FAssetListItem>& AssetItem : SelectedAssetItems)
+	{
+		AssetDataToPlan.Add(AssetListModel->MakeAssetData(AssetItem->Index));
 	}
 
+	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+	SuperManagerModule.PlanDeletion(AssetDataToPlan);
+
 	return FReply::Handled();
 }
 
@@ -343,12 +1008,10 @@ TSharedRef<SButton> SAdvancedDeletionTab::ConstructSelectAllButton()
 
 FReply SAdvancedDeletionTab::OnSelectAllButtonClicked()
 {
-	for (const TSharedRef<SCheckBox> CheckBox : CheckBoxesArray)
+	// Every displayed asset, not only the rows currently on screen
+	for (const TSharedPtr<FAssetListItem>& AssetItem : DisplayedAssetItemsArray)
 	{
-		if (!CheckBox->IsChecked())
-		{
-			CheckBox->ToggleCheckedState();
-		}
+		AssetListModel->SetSelected(AssetItem->Index, true);
 	}
 
 	return FReply::Handled();
@@ -368,12 +1031,10 @@ TSharedRef<SButton> SAdvancedDeletionTab::ConstructDeselectAllButton()
 
 FReply SAdvancedDeletionTab::OnDeselectAllButtonClicked()
 {
-	for (const TSharedRef<SCheckBox> CheckBox : CheckBoxesArray)
+	// Same rows as Select All, selected rows hidden by the search, the tag filter or the class facets keep their check state
+	for (const TSharedPtr<FAssetListItem>& AssetItem : DisplayedAssetItemsArray)
 	{
-		if (CheckBox->IsChecked())
-		{
-			CheckBox->ToggleCheckedState();
-		}
+		AssetListModel->SetSelected(AssetItem->Index, false);
 	}
 
 	return FReply::Handled();
@@ -420,28 +1081,37 @@ TSharedRef<SWidget> SAdvancedDeletionTab::OnGenerateComboBoxContent(TSharedPtr<F
 void SAdvancedDeletionTab::OnComboBoxSelectionChanged(TSharedPtr<FString> SelectedOption, ESelectInfo::Type InSelectInfo)
 {
 	ComboBoxDisplayTextBlock->SetText(FText::FromString(*SelectedOption.Get()));
+	CurrentListingCondition = *SelectedOption.Get();
+
+	// A new listing condition replaces whatever is still streaming in
+	CancelUnusedAssetsScan();
 
 	// Pass data for our module to filter based on the selected option
 	if (*SelectedOption.Get() == LIST_ALL)
 	{
 		// List all stored assets
-		DisplayedAssetsDataArray = StoredAssetsDataArray;
+		ListedAssetItemsArray = StoredAssetItemsArray;
 		RefreshAssetListView();
 	}
 	else if (*SelectedOption.Get() == LIST_UNUSED)
 	{
-		// List all unused assets
-		FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
-		SuperManagerModule.ListUnusedAssetsForAssetList(StoredAssetsDataArray, DisplayedAssetsDataArray);
+		// List all unused assets, results stream in from a background scan
+		ListedAssetItemsArray.Empty();
 		RefreshAssetListView();
+		StartUnusedAssetsScan();
 	}
 	else if (*SelectedOption.Get() == LIST_SAME_NAME)
 	{
 		// List all assets with the same name
 		FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
-		SuperManagerModule.ListSameNameAssetsForAssetList(StoredAssetsDataArray, DisplayedAssetsDataArray);
+		SuperManagerModule.ListSameNameAssetsForAssetList(*AssetListModel, StoredAssetItemsArray, ListedAssetItemsArray);
 		RefreshAssetListView();
 	}
+	else if (*SelectedOption.Get() == LIST_UNREACHABLE)
+	{
+		// List all assets that no map, primary asset or always cooked folder leads to
+		ListUnreachableAssets();
+	}
 }
 
 TSharedRef<STextBlock> SAdvancedDeletionTab::ConstructComboBoxHelpText(const FString& TextContent, ETextJustify::Type TextJustify)
@@ -454,3 +1124,359 @@ TSharedRef<STextBlock> SAdvancedDeletionTab::ConstructComboBoxHelpText(const FSt
 
 	return ConstructedHelpText;
 }
+
+TSharedRef<SHorizontalBox> SAdvancedDeletionTab::ConstructScanProgressBox()
+{
+	TSharedRef<SHorizontalBox> ConstructedScanProgressBox =
+		SNew(SHorizontalBox)
+		.Visibility(this, &SAdvancedDeletionTab::GetScanProgressVisibility)
+
+		// Progress bar slot
+		+SHorizontalBox::Slot()
+		.FillWidth(0.5f)
+		.VAlign(EVerticalAlignment::VAlign_Center)
+		.Padding(FMargin(0.0f, 0.0f, 5.0f, 0.0f))
+		[
+			SNew(SProgressBar)
+			.Percent(this, &SAdvancedDeletionTab::GetScanProgressPercent)
+		]
+
+		// Status and throughput slot
+		+SHorizontalBox::Slot()
+		.FillWidth(0.4f)
+		.VAlign(EVerticalAlignment::VAlign_Center)
+		[
+			SNew(STextBlock)
+			.Text(this, &SAdvancedDeletionTab::GetScanStatusText)
+		]
+
+		// Cancel button slot
+		+SHorizontalBox::Slot()
+		.AutoWidth()
+		[
+			SNew(SButton)
+			.Text(FText::FromString(TEXT("Cancel")))
+			.OnClicked(this, &SAdvancedDeletionTab::OnCancelScanButtonClicked)
+		];
+
+	return ConstructedScanProgressBox;
+}
+
+EVisibility SAdvancedDeletionTab::GetScanProgressVisibility() const
+{
+	return UnusedAssetsScanner.IsValid() ? EVisibility::Visible : EVisibility::Collapsed;
+}
+
+TOptional<float> SAdvancedDeletionTab::GetScanProgressPercent() const
+{
+	if (!UnusedAssetsScanner.IsValid())
+	{
+		return TOptional<float>();
+	}
+
+	return UnusedAssetsScanner->GetProgress();
+}
+
+FText SAdvancedDeletionTab::GetScanStatusText() const
+{
+	if (!UnusedAssetsScanner.IsValid())
+	{
+		return FText::GetEmpty();
+	}
+
+	return FText::FromString(FString::Printf(TEXT("Scanned %d / %d assets (%.0f assets/sec) - %d unused found"),
+		UnusedAssetsScanner->GetNumScanned(),
+		UnusedAssetsScanner->GetNumToScan(),
+		UnusedAssetsScanner->GetAssetsPerSecond(),
+		ListedAssetItemsArray.Num()));
+}
+
+FReply SAdvancedDeletionTab::OnCancelScanButtonClicked()
+{
+	CancelUnusedAssetsScan();
+	return FReply::Handled();
+}
+
+void SAdvancedDeletionTab::StartUnusedAssetsScan()
+{
+	CancelUnusedAssetsScan();
+
+	// The scanner reports indices into this copy, so deleting rows meanwhile can't shift them
+	UnusedAssetsScanSourceArray = StoredAssetItemsArray;
+
+	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+	UnusedAssetsScanner = SuperManagerModule.StartUnusedAssetsScanForAssetList(*AssetListModel, UnusedAssetsScanSourceArray);
+
+	UnusedAssetsScanTimerHandle = RegisterActiveTimer(0.1f, FWidgetActiveTimerDelegate::CreateSP(this, &SAdvancedDeletionTab::UpdateUnusedAssetsScan));
+}
+
+void SAdvancedDeletionTab::CancelUnusedAssetsScan()
+{
+	if (UnusedAssetsScanner.IsValid())
+	{
+		UnusedAssetsScanner->Cancel();
+		UnusedAssetsScanner.Reset();
+	}
+
+	if (UnusedAssetsScanTimerHandle.IsValid())
+	{
+		UnRegisterActiveTimer(UnusedAssetsScanTimerHandle.ToSharedRef());
+		UnusedAssetsScanTimerHandle.Reset();
+	}
+
+	UnusedAssetsScanSourceArray.Empty();
+	UnusedAssetsScanResults.Empty();
+}
+
+EActiveTimerReturnType SAdvancedDeletionTab::UpdateUnusedAssetsScan(double InCurrentTime, float InDeltaTime)
+{
+	if (!UnusedAssetsScanner.IsValid())
+	{
+		UnusedAssetsScanTimerHandle.Reset();
+		return EActiveTimerReturnType::Stop;
+	}
+
+	// Read the completion flag first so no batch published before it is missed
+	const bool bIsScanComplete = UnusedAssetsScanner->IsComplete();
+
+	UnusedAssetsScanResults.Reset();
+	UnusedAssetsScanner->DrainResults(UnusedAssetsScanResults);
+
+	bool bClassesChanged = false;
+
+	for (const int32 ResultIndex : UnusedAssetsScanResults)
+	{
+		const TSharedPtr<FAssetListItem>& ResultItem = UnusedAssetsScanSourceArray[ResultIndex];
+
+		// Assets deleted while the scan was running are already marked removed
+		if (AssetListModel->IsRemoved(ResultItem->Index))
+		{
+			continue;
+		}
+
+		AddListedAssetItem(ResultItem, bClassesChanged);
+	}
+
+	if (bClassesChanged)
+	{
+		RebuildClassFacets();
+	}
+
+	// Append the new rows without throwing away the existing ones or their check state
+	if (UnusedAssetsScanResults.Num() > 0 && ConstructedAssetListView.IsValid())
+	{
+		ConstructedAssetListView->RequestListRefresh();
+	}
+
+	if (!bIsScanComplete)
+	{
+		return EActiveTimerReturnType::Continue;
+	}
+
+	// Results streamed in unsorted
+	SortListedAssetItems();
+	ApplySearch(false);
+
+	if (ConstructedAssetListView.IsValid())
+	{
+		ConstructedAssetListView->RequestListRefresh();
+	}
+
+	DebugHeader::ShowNotifyInfo(FString::Printf(TEXT("Found %d unused assets in %d assets (%.0f assets/sec)"),
+		ListedAssetItemsArray.Num(), UnusedAssetsScanner->GetNumToScan(), UnusedAssetsScanner->GetAssetsPerSecond()));
+
+	UnusedAssetsScanner.Reset();
+	UnusedAssetsScanTimerHandle.Reset();
+	UnusedAssetsScanSourceArray.Empty();
+	UnusedAssetsScanResults.Empty();
+
+	return EActiveTimerReturnType::Stop;
+}
+
+void SAdvancedDeletionTab::OnUnusedAssetsChanged(const TArray<FName>& ChangedPackageNames)
+{
+	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+
+	// Only the rows of the changed packages are refreshed, their cells are bound to the model
+	TSharedPtr<FAssetReferenceIndex, ESPMode::ThreadSafe> ReferenceIndex = SuperManagerModule.GetAssetReferenceIndex();
+	if (ReferenceIndex.IsValid())
+	{
+		AssetListModel->UpdateReferencerCounts(*ReferenceIndex, ChangedPackageNames);
+	}
+
+	// A running scan will pick up the new state itself
+	if (CurrentListingCondition != LIST_UNUSED || UnusedAssetsScanner.IsValid() || ChangedPackageNames.Num() == 0)
+	{
+		return;
+	}
+
+	FUnusedAssetsTracker& UnusedAssetsTracker = SuperManagerModule.GetUnusedAssetsTracker();
+
+	TSet<FName> NoLongerUnusedPackageNames;
+	TSet<FName> UnusedPackageNames;
+
+	for (const FName& ChangedPackageName : ChangedPackageNames)
+	{
+		if (!UnusedAssetsTracker.IsPackageUnused(ChangedPackageName))
+		{
+			NoLongerUnusedPackageNames.Add(ChangedPackageName);
+		}
+		else
+		{
+			const FString ChangedPackagePath = ChangedPackageName.ToString();
+			if (IsPackageInSelectedFolders(ChangedPackagePath) && !FPathExclusionRules::Get().IsPackageExcluded(ChangedPackagePath))
+			{
+				UnusedPackageNames.Add(ChangedPackageName);
+			}
+		}
+	}
+
+	// Rows that stay listed keep their check state, the dropped ones are deselected
+	int32 NumChanged = 0;
+	if (NoLongerUnusedPackageNames.Num() > 0)
+	{
+		NumChanged += RemoveListedAssetItems([this, &NoLongerUnusedPackageNames](const TSharedPtr<FAssetListItem>& AssetItem)
+		{
+			if (!NoLongerUnusedPackageNames.Contains(AssetListModel->GetPackageName(AssetItem->Index)))
+			{
+				return false;
+			}
+
+			AssetListModel->SetSelected(AssetItem->Index, false);
+			return true;
+		});
+	}
+
+	if (UnusedPackageNames.Num() > 0)
+	{
+		// Already listed rows stay as they are
+		for (const TSharedPtr<FAssetListItem>& ListedAssetItem : ListedAssetItemsArray)
+		{
+			UnusedPackageNames.Remove(AssetListModel->GetPackageName(ListedAssetItem->Index));
+		}
+
+		TArray<TSharedPtr<FAssetListItem>> UnusedAssetItems;
+
+		// Rows the tab already holds are listed again, packages it never held are read from the registry
+		TSet<FName> StoredPackageNames;
+		for (const TSharedPtr<FAssetListItem>& StoredAssetItem : StoredAssetItemsArray)
+		{
+			const FName StoredPackageName = AssetListModel->GetPackageName(StoredAssetItem->Index);
+			if (UnusedPackageNames.Contains(StoredPackageName))
+			{
+				UnusedAssetItems.Add(StoredAssetItem);
+				StoredPackageNames.Add(StoredPackageName);
+			}
+		}
+
+		FARFilter Filter;
+		for (const FName& UnusedPackageName : UnusedPackageNames)
+		{
+			if (!StoredPackageNames.Contains(UnusedPackageName))
+			{
+				Filter.PackageNames.Add(UnusedPackageName);
+			}
+		}
+
+		if (Filter.PackageNames.Num() > 0)
+		{
+			TArray<FAssetData> NewAssetsData;
+			IAssetRegistry::GetChecked().GetAssets(Filter, NewAssetsData);
+
+			for (const FAssetData& NewAssetData : NewAssetsData)
+			{
+				const TSharedPtr<FAssetListItem> NewAssetItem = AssetListModel->GetItem(AssetListModel->Add(NewAssetData));
+				StoredAssetItemsArray.Add(NewAssetItem);
+				UnusedAssetItems.Add(NewAssetItem);
+			}
+
+			if (ReferenceIndex.IsValid())
+			{
+				AssetListModel->UpdateReferencerCounts(*ReferenceIndex, Filter.PackageNames);
+			}
+
+			// The new rows have no tag filter bits yet, only their tag values are queried
+			if (NewAssetsData.Num() > 0 && !TagFilter.IsEmpty())
+			{
+				TagFilter.Evaluate(*AssetListModel, TagFilterMatches);
+			}
+		}
+
+		bool bClassesChanged = false;
+		for (const TSharedPtr<FAssetListItem>& UnusedAssetItem : UnusedAssetItems)
+		{
+			AddListedAssetItem(UnusedAssetItem, bClassesChanged);
+		}
+
+		if (bClassesChanged)
+		{
+			RebuildClassFacets();
+		}
+
+		// Appended rows go to the end, keep the chosen order
+		if (UnusedAssetItems.Num() > 0 && SortMode != EColumnSortMode::None)
+		{
+			SortListedAssetItems();
+			ApplySearch(false);
+		}
+
+		NumChanged += UnusedAssetItems.Num();
+	}
+
+	if (NumChanged == 0)
+	{
+		return;
+	}
+
+	if (ConstructedAssetListView.IsValid())
+	{
+		ConstructedAssetListView->RequestListRefresh();
+	}
+}
+
+bool SAdvancedDeletionTab::IsPackageInSelectedFolders(const FString& PackageName) const
+{
+	for (const FString& SelectedFolder : SelectedFolders)
+	{
+		if (PackageName.StartsWith(SelectedFolder))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void SAdvancedDeletionTab::OnReferenceIndexReady()
+{
+	UpdateReferencerCounts();
+
+	// Sorted on the counts known so far until now
+	if (SortColumnId == ReferencersColumnId)
+	{
+		SortListedAssetItems();
+		ApplySearch(false);
+
+		if (ConstructedAssetListView.IsValid())
+		{
+			ConstructedAssetListView->RequestListRefresh();
+		}
+	}
+
+	if (CurrentListingCondition == LIST_UNREACHABLE)
+	{
+		ListUnreachableAssets();
+	}
+}
+
+void SAdvancedDeletionTab::ListUnreachableAssets()
+{
+	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+	if (!SuperManagerModule.ListUnreachableAssetsForAssetList(*AssetListModel, StoredAssetItemsArray, ListedAssetItemsArray))
+	{
+		// Listed from OnReferenceIndexReady instead of waiting for the build here
+		DebugHeader::ShowNotifyInfo(TEXT("Asset references are still being indexed, unreachable assets will be listed when it finishes"));
+	}
+
+	RefreshAssetListView();
+}
@@ -0,0 +1,225 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SlateWidgets/AssetListModel.h"
+#include "AssetAnalysis/AssetReferenceIndex.h"
+#include "AssetRegistryModule.h"
+
+namespace
+{
+	/** Plain numbers, and dimensions like 2048x1024 which read as their largest side */
+	bool TryParseNumericTagValue(const FString& TagValue, double& OutNumber)
+	{
+		if (LexTryParseString(OutNumber, *TagValue))
+		{
+			return true;
+		}
+
+		TArray<FString> Dimensions;
+		if (TagValue.ParseIntoArray(Dimensions, TEXT("x")) < 2)
+		{
+			return false;
+		}
+
+		OutNumber = 0.0;
+		for (const FString& Dimension : Dimensions)
+		{
+			double DimensionSize = 0.0;
+			if (!LexTryParseString(DimensionSize, *Dimension))
+			{
+				return false;
+			}
+
+			OutNumber = FMath::Max(OutNumber, DimensionSize);
+		}
+
+		return true;
+	}
+}
+
+void FAssetListModel::Reserve(int32 NumAssets)
+{
+	PackageNames.Reserve(NumAssets);
+	PackagePaths.Reserve(NumAssets);
+	AssetNames.Reserve(NumAssets);
+	AssetClasses.Reserve(NumAssets);
+	RowsByPackageName.Reserve(NumAssets);
+	DiskSizes.Reserve(NumAssets);
+	ReferencerCounts.Reserve(NumAssets);
+	Flags.Reserve(NumAssets);
+	SelectedRows.Reserve(NumAssets);
+}
+
+int32 FAssetListModel::Add(const FAssetData& AssetData)
+{
+	const int32 Index = PackageNames.Add(AssetData.PackageName);
+	PackagePaths.Add(AssetData.PackagePath);
+	AssetNames.Add(AssetData.AssetName);
+	AssetClasses.Add(AssetData.AssetClass);
+	RowsByPackageName.Add(AssetData.PackageName, Index);
+	DiskSizes.Add(INDEX_NONE);
+	ReferencerCounts.Add(INDEX_NONE);
+	Flags.Add(EAssetListItemFlags::None);
+	Items.AddElement(FAssetListItem(Index));
+	SelectedRows.Add(false);
+
+	return Index;
+}
+
+void FAssetListModel::Append(TConstArrayView<FAssetData> AssetsData)
+{
+	Reserve(Num() + AssetsData.Num());
+
+	for (const FAssetData& AssetData : AssetsData)
+	{
+		Add(AssetData);
+	}
+}
+
+TSharedPtr<FAssetListItem> FAssetListModel::GetItem(int32 Index)
+{
+	return TSharedPtr<FAssetListItem>(AsShared(), &Items[Index]);
+}
+
+int64 FAssetListModel::ReadDiskSize(int32 Index)
+{
+	int64& DiskSize = DiskSizes[Index];
+	if (DiskSize == INDEX_NONE)
+	{
+		TOptional<FAssetPackageData> PackageData = IAssetRegistry::GetChecked().GetAssetPackageDataCopy(PackageNames[Index]);
+		DiskSize = PackageData.IsSet() ? PackageData->DiskSize : 0;
+	}
+
+	return DiskSize;
+}
+
+const FAssetTagColumn& FAssetListModel::GetTagColumn(FName TagName)
+{
+	TUniquePtr<FAssetTagColumn>& TagColumn = TagColumns.FindOrAdd(TagName);
+	if (!TagColumn.IsValid())
+	{
+		TagColumn = MakeUnique<FAssetTagColumn>();
+	}
+
+	// Only rows added since the last extraction are read
+	const int32 FirstNewIndex = TagColumn->Num();
+	if (FirstNewIndex == Num())
+	{
+		return *TagColumn;
+	}
+
+	FARFilter Filter;
+	Filter.PackageNames.Reserve(Num() - FirstNewIndex);
+	for (int32 Index = FirstNewIndex; Index < Num(); ++Index)
+	{
+		Filter.PackageNames.Add(PackageNames[Index]);
+	}
+
+	// New rows start without a value, the ones the registry has the tag for are filled in below
+	TagColumn->NumericValues.SetNumZeroed(Num());
+	TagColumn->StringValues.SetNum(Num());
+	TagColumn->HasValues.Add(false, Num() - FirstNewIndex);
+	TagColumn->HasNumericValues.Add(false, Num() - FirstNewIndex);
+
+	// The tag maps are shared with the registry, the model doesn't keep them between filters
+	TArray<FAssetData> AssetsData;
+	IAssetRegistry::GetChecked().GetAssets(Filter, AssetsData);
+
+	TArray<int32, TInlineAllocator<4>> PackageRows;
+	for (const FAssetData& AssetData : AssetsData)
+	{
+		const FAssetDataTagMapSharedView::FFindTagResult TagValue = AssetData.TagsAndValues.FindTag(TagName);
+		if (!TagValue.IsSet())
+		{
+			continue;
+		}
+
+		PackageRows.Reset();
+		RowsByPackageName.MultiFind(AssetData.PackageName, PackageRows);
+
+		const FString Value = TagValue.GetValue();
+
+		double NumericValue = 0.0;
+		const bool bIsNumeric = TryParseNumericTagValue(Value, NumericValue);
+
+		for (const int32 Index : PackageRows)
+		{
+			if (Index < FirstNewIndex || AssetNames[Index] != AssetData.AssetName)
+			{
+				continue;
+			}
+
+			TagColumn->NumericValues[Index] = bIsNumeric ? NumericValue : 0.0;
+			TagColumn->StringValues[Index] = Value.ToLower();
+			TagColumn->HasValues[Index] = true;
+			TagColumn->HasNumericValues[Index] = bIsNumeric;
+		}
+	}
+
+	return *TagColumn;
+}
+
+void FAssetListModel::UpdateReferencerCounts(const FAssetReferenceIndex& ReferenceIndex)
+{
+	for (int32 Index = 0; Index < PackageNames.Num(); ++Index)
+	{
+		ReferencerCounts[Index] = ReferenceIndex.GetReferencerCount(PackageNames[Index]);
+	}
+
+	bHasReferencerCounts = true;
+}
+
+void FAssetListModel::UpdateReferencerCounts(const FAssetReferenceIndex& ReferenceIndex, TConstArrayView<FName> ChangedPackageNames)
+{
+	TArray<int32, TInlineAllocator<4>> PackageRows;
+	for (const FName& ChangedPackageName : ChangedPackageNames)
+	{
+		PackageRows.Reset();
+		RowsByPackageName.MultiFind(ChangedPackageName, PackageRows);
+
+		if (PackageRows.Num() == 0)
+		{
+			continue;
+		}
+
+		const int32 ReferencerCount = ReferenceIndex.GetReferencerCount(ChangedPackageName);
+		for (const int32 Index : PackageRows)
+		{
+			ReferencerCounts[Index] = ReferencerCount;
+		}
+	}
+}
+
+void FAssetListModel::MarkRemoved(int32 Index)
+{
+	Flags[Index] |= EAssetListItemFlags::Removed;
+	SetSelected(Index, false);
+}
+
+void FAssetListModel::SetSelected(int32 Index, bool bSelected)
+{
+	FBitReference SelectedBit = SelectedRows[Index];
+	if (SelectedBit != bSelected)
+	{
+		SelectedBit = bSelected;
+		NumSelected += bSelected ? 1 : -1;
+	}
+}
+
+void FAssetListModel::ClearSelection()
+{
+	if (NumSelected > 0)
+	{
+		SelectedRows.SetRange(0, SelectedRows.Num(), false);
+		NumSelected = 0;
+	}
+}
+
+FString FAssetListModel::GetObjectPath(int32 Index) const
+{
+	return PackageNames[Index].ToString() + TEXT(".") + AssetNames[Index].ToString();
+}
+
+FAssetData FAssetListModel::MakeAssetData(int32 Index) const
+{
+	return FAssetData(PackageNames[Index], PackagePaths[Index], AssetNames[Index], AssetClasses[Index]);
+}
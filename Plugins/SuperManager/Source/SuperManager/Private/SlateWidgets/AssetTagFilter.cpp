@@ -0,0 +1,286 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SlateWidgets/AssetTagFilter.h"
+#include "SlateWidgets/AssetListModel.h"
+
+namespace
+{
+	struct FExpressionToken
+	{
+		FString Text;
+
+		/** Operators and connectives made of symbols, e.g. >= or && */
+		bool bIsSymbol = false;
+
+		/** Quoted values are never read as a keyword or a number */
+		bool bIsQuoted = false;
+	};
+
+	bool IsSymbolCharacter(TCHAR Character)
+	{
+		return Character == TEXT('=') || Character == TEXT('!') || Character == TEXT('<') || Character == TEXT('>')
+			|| Character == TEXT('~') || Character == TEXT('&') || Character == TEXT('|');
+	}
+
+	bool TokenizeExpression(const FString& Expression, TArray<FExpressionToken>& OutTokens, FString& OutError)
+	{
+		int32 Index = 0;
+		while (Index < Expression.Len())
+		{
+			const TCHAR Character = Expression[Index];
+			if (FChar::IsWhitespace(Character))
+			{
+				++Index;
+				continue;
+			}
+
+			FExpressionToken& Token = OutTokens.AddDefaulted_GetRef();
+
+			if (Character == TEXT('"'))
+			{
+				const int32 ClosingQuoteIndex = Expression.Find(TEXT("\""), ESearchCase::CaseSensitive, ESearchDir::FromStart, Index + 1);
+				if (ClosingQuoteIndex == INDEX_NONE)
+				{
+					OutError = TEXT("Missing closing quote");
+					return false;
+				}
+
+				Token.Text = Expression.Mid(Index + 1, ClosingQuoteIndex - Index - 1);
+				Token.bIsQuoted = true;
+				Index = ClosingQuoteIndex + 1;
+				continue;
+			}
+
+			const int32 TokenStartIndex = Index;
+			Token.bIsSymbol = IsSymbolCharacter(Character);
+
+			while (Index < Expression.Len() && !FChar::IsWhitespace(Expression[Index]) && Expression[Index] != TEXT('"')
+				&& IsSymbolCharacter(Expression[Index]) == Token.bIsSymbol)
+			{
+				++Index;
+			}
+
+			Token.Text = Expression.Mid(TokenStartIndex, Index - TokenStartIndex);
+		}
+
+		return true;
+	}
+
+	bool TryParseOperator(const FExpressionToken& Token, EAssetTagFilterOperator& OutOperator)
+	{
+		static const TMap<FString, EAssetTagFilterOperator> Operators =
+		{
+			{ TEXT("=="), EAssetTagFilterOperator::Equal },
+			{ TEXT("="), EAssetTagFilterOperator::Equal },
+			{ TEXT("!="), EAssetTagFilterOperator::NotEqual },
+			{ TEXT("<"), EAssetTagFilterOperator::Less },
+			{ TEXT("<="), EAssetTagFilterOperator::LessEqual },
+			{ TEXT(">"), EAssetTagFilterOperator::Greater },
+			{ TEXT(">="), EAssetTagFilterOperator::GreaterEqual },
+			{ TEXT("~"), EAssetTagFilterOperator::Contains }
+		};
+
+		const EAssetTagFilterOperator* Operator = Token.bIsSymbol ? Operators.Find(Token.Text) : nullptr;
+		if (Operator == nullptr)
+		{
+			return false;
+		}
+
+		OutOperator = *Operator;
+		return true;
+	}
+
+	bool IsConnective(const FExpressionToken& Token, const TCHAR* Keyword, const TCHAR* Symbol)
+	{
+		if (Token.bIsQuoted)
+		{
+			return false;
+		}
+
+		return Token.bIsSymbol ? Token.Text == Symbol : Token.Text.Equals(Keyword, ESearchCase::IgnoreCase);
+	}
+
+	/** Clears the rows whose value fails the comparison, rows without a number never match */
+	template <typename ComparatorType>
+	void MatchNumericRows(const FAssetTagColumn& TagColumn, TBitArray<>& InOutMatches, ComparatorType Comparator)
+	{
+		for (int32 Index = 0; Index < TagColumn.Num(); ++Index)
+		{
+			if (InOutMatches[Index] && !(TagColumn.HasNumericValues[Index] && Comparator(TagColumn.NumericValues[Index])))
+			{
+				InOutMatches[Index] = false;
+			}
+		}
+	}
+
+	/** Same for the lowercase strings, rows without the tag never match */
+	template <typename ComparatorType>
+	void MatchStringRows(const FAssetTagColumn& TagColumn, TBitArray<>& InOutMatches, ComparatorType Comparator)
+	{
+		for (int32 Index = 0; Index < TagColumn.Num(); ++Index)
+		{
+			if (InOutMatches[Index] && !(TagColumn.HasValues[Index] && Comparator(TagColumn.StringValues[Index])))
+			{
+				InOutMatches[Index] = false;
+			}
+		}
+	}
+}
+
+bool FAssetTagFilter::Parse(const FString& Expression, FString& OutError)
+{
+	Clauses.Reset();
+
+	TArray<FExpressionToken> Tokens;
+	if (!TokenizeExpression(Expression, Tokens, OutError))
+	{
+		return false;
+	}
+
+	TArray<TArray<FAssetTagPredicate>> ParsedClauses;
+	if (Tokens.Num() > 0)
+	{
+		ParsedClauses.AddDefaulted();
+	}
+
+	int32 TokenIndex = 0;
+	while (TokenIndex < Tokens.Num())
+	{
+		if (TokenIndex + 2 >= Tokens.Num())
+		{
+			OutError = FString::Printf(TEXT("Expected <Tag> <Operator> <Value> at \"%s\""), *Tokens[TokenIndex].Text);
+			return false;
+		}
+
+		const FExpressionToken& TagToken = Tokens[TokenIndex];
+		const FExpressionToken& OperatorToken = Tokens[TokenIndex + 1];
+		const FExpressionToken& ValueToken = Tokens[TokenIndex + 2];
+
+		if (TagToken.bIsSymbol || TagToken.bIsQuoted || ValueToken.bIsSymbol)
+		{
+			OutError = FString::Printf(TEXT("Expected <Tag> <Operator> <Value> at \"%s\""), *TagToken.Text);
+			return false;
+		}
+
+		FAssetTagPredicate& Predicate = ParsedClauses.Last().AddDefaulted_GetRef();
+		Predicate.TagName = FName(*TagToken.Text);
+
+		if (!TryParseOperator(OperatorToken, Predicate.Operator))
+		{
+			OutError = FString::Printf(TEXT("Unknown operator \"%s\", use == != < <= > >= or ~"), *OperatorToken.Text);
+			return false;
+		}
+
+		Predicate.StringValue = ValueToken.Text.ToLower();
+		Predicate.bIsNumeric = !ValueToken.bIsQuoted && Predicate.Operator != EAssetTagFilterOperator::Contains
+			&& LexTryParseString(Predicate.NumericValue, *ValueToken.Text);
+
+		TokenIndex += 3;
+		if (TokenIndex == Tokens.Num())
+		{
+			break;
+		}
+
+		const FExpressionToken& ConnectiveToken = Tokens[TokenIndex];
+		if (IsConnective(ConnectiveToken, TEXT("OR"), TEXT("||")))
+		{
+			ParsedClauses.AddDefaulted();
+		}
+		else if (!IsConnective(ConnectiveToken, TEXT("AND"), TEXT("&&")))
+		{
+			OutError = FString::Printf(TEXT("Expected AND or OR at \"%s\""), *ConnectiveToken.Text);
+			return false;
+		}
+
+		if (++TokenIndex == Tokens.Num())
+		{
+			OutError = FString::Printf(TEXT("Expression ends after \"%s\""), *ConnectiveToken.Text);
+			return false;
+		}
+	}
+
+	Clauses = MoveTemp(ParsedClauses);
+	return true;
+}
+
+void FAssetTagFilter::Evaluate(FAssetListModel& AssetListModel, TBitArray<>& OutMatches) const
+{
+	OutMatches.Init(IsEmpty(), AssetListModel.Num());
+
+	TBitArray<> ClauseMatches;
+	for (const TArray<FAssetTagPredicate>& Clause : Clauses)
+	{
+		ClauseMatches.Init(true, AssetListModel.Num());
+
+		for (const FAssetTagPredicate& Predicate : Clause)
+		{
+			EvaluatePredicate(AssetListModel, Predicate, ClauseMatches);
+		}
+
+		OutMatches.CombineWithBitwiseOR(ClauseMatches, EBitwiseOperatorFlags::MaintainSize);
+	}
+}
+
+void FAssetTagFilter::EvaluatePredicate(FAssetListModel& AssetListModel, const FAssetTagPredicate& Predicate, TBitArray<>& InOutMatches)
+{
+	const FAssetTagColumn& TagColumn = AssetListModel.GetTagColumn(Predicate.TagName);
+
+	// The operator is picked once, each loop below only compares
+	if (Predicate.bIsNumeric)
+	{
+		const double Value = Predicate.NumericValue;
+
+		switch (Predicate.Operator)
+		{
+		case EAssetTagFilterOperator::Equal:
+			MatchNumericRows(TagColumn, InOutMatches, [Value](double RowValue) { return RowValue == Value; });
+			break;
+		case EAssetTagFilterOperator::NotEqual:
+			MatchNumericRows(TagColumn, InOutMatches, [Value](double RowValue) { return RowValue != Value; });
+			break;
+		case EAssetTagFilterOperator::Less:
+			MatchNumericRows(TagColumn, InOutMatches, [Value](double RowValue) { return RowValue < Value; });
+			break;
+		case EAssetTagFilterOperator::LessEqual:
+			MatchNumericRows(TagColumn, InOutMatches, [Value](double RowValue) { return RowValue <= Value; });
+			break;
+		case EAssetTagFilterOperator::Greater:
+			MatchNumericRows(TagColumn, InOutMatches, [Value](double RowValue) { return RowValue > Value; });
+			break;
+		case EAssetTagFilterOperator::GreaterEqual:
+			MatchNumericRows(TagColumn, InOutMatches, [Value](double RowValue) { return RowValue >= Value; });
+			break;
+		case EAssetTagFilterOperator::Contains:
+			break;
+		}
+
+		return;
+	}
+
+	const FString& Value = Predicate.StringValue;
+
+	switch (Predicate.Operator)
+	{
+	case EAssetTagFilterOperator::Equal:
+		MatchStringRows(TagColumn, InOutMatches, [&Value](const FString& RowValue) { return RowValue.Equals(Value, ESearchCase::CaseSensitive); });
+		break;
+	case EAssetTagFilterOperator::NotEqual:
+		MatchStringRows(TagColumn, InOutMatches, [&Value](const FString& RowValue) { return !RowValue.Equals(Value, ESearchCase::CaseSensitive); });
+		break;
+	case EAssetTagFilterOperator::Less:
+		MatchStringRows(TagColumn, InOutMatches, [&Value](const FString& RowValue) { return RowValue.Compare(Value, ESearchCase::CaseSensitive) < 0; });
+		break;
+	case EAssetTagFilterOperator::LessEqual:
+		MatchStringRows(TagColumn, InOutMatches, [&Value](const FString& RowValue) { return RowValue.Compare(Value, ESearchCase::CaseSensitive) <= 0; });
+		break;
+	case EAssetTagFilterOperator::Greater:
+		MatchStringRows(TagColumn, InOutMatches, [&Value](const FString& RowValue) { return RowValue.Compare(Value, ESearchCase::CaseSensitive) > 0; });
+		break;
+	case EAssetTagFilterOperator::GreaterEqual:
+		MatchStringRows(TagColumn, InOutMatches, [&Value](const FString& RowValue) { return RowValue.Compare(Value, ESearchCase::CaseSensitive) >= 0; });
+		break;
+	case EAssetTagFilterOperator::Contains:
+		MatchStringRows(TagColumn, InOutMatches, [&Value](const FString& RowValue) { return RowValue.Contains(Value, ESearchCase::CaseSensitive); });
+		break;
+	}
+}
@@ -0,0 +1,281 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SlateWidgets/FolderFootprintWidget.h"
+#include "Widgets/Notifications/SProgressBar.h"
+#include "SuperManagerModule.h"
+
+void SFolderFootprintTab::Construct(const FArguments& InArgs)
+{
+	bCanSupportFocus = true;
+
+	RootFolder = InArgs._RootFolder;
+
+	FSlateFontInfo TitleTextFont = FCoreStyle::Get().GetFontStyle(FName("EmbossedText"));
+	TitleTextFont.Size = 30;
+
+	ChildSlot
+	[
+		// Main vertical box
+		SNew(SVerticalBox)
+
+		// 1st Slot for title text
+		+SVerticalBox::Slot()
+		.AutoHeight()
+		[
+			SNew(STextBlock)
+			.Text(FText::FromString(TEXT("Folder Footprint")))
+			.Font(TitleTextFont)
+			.Justification(ETextJustify::Center)
+			.ColorAndOpacity(FColor::White)
+		]
+
+		// 2nd Slot for the summary and the refresh button
+		+SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(5.0f)
+		[
+			SNew(SHorizontalBox)
+
+			+SHorizontalBox::Slot()
+			.FillWidth(1.0f)
+			.VAlign(EVerticalAlignment::VAlign_Center)
+			[
+				SNew(STextBlock)
+				.Text(this, &SFolderFootprintTab::GetSummaryText)
+				.AutoWrapText(true)
+			]
+
+			+SHorizontalBox::Slot()
+			.AutoWidth()
+			[
+				ConstructRefreshButton()
+			]
+		]
+
+		// 3rd Slot for the folders and the classes side by side
+		+SVerticalBox::Slot()
+		.VAlign(EVerticalAlignment::VAlign_Fill)
+		[
+			SNew(SHorizontalBox)
+
+			+SHorizontalBox::Slot()
+			.FillWidth(0.65f)
+			.Padding(5.0f)
+			[
+				SNew(SVerticalBox)
+
+				+SVerticalBox::Slot()
+				.AutoHeight()
+				[
+					ConstructListTitle(TEXT("Folders, double click to browse"))
+				]
+
+				+SVerticalBox::Slot()
+				[
+					ConstructFolderListView()
+				]
+			]
+
+			+SHorizontalBox::Slot()
+			.FillWidth(0.35f)
+			.Padding(5.0f)
+			[
+				SNew(SVerticalBox)
+
+				+SVerticalBox::Slot()
+				.AutoHeight()
+				[
+					ConstructListTitle(TEXT("Classes"))
+				]
+
+				+SVerticalBox::Slot()
+				[
+					ConstructClassListView()
+				]
+			]
+		]
+	];
+
+	RequestFootprint(false);
+}
+
+TSharedRef<SListView<TSharedPtr<FFolderFootprintEntry>>> SFolderFootprintTab::ConstructFolderListView()
+{
+	ConstructedFolderListView =
+		SNew(SListView<TSharedPtr<FFolderFootprintEntry>>)
+		.ItemHeight(24.0f)
+		.ListItemsSource(&FolderItemsArray)
+		.OnGenerateRow(this, &SFolderFootprintTab::OnGenerateRowForFootprint)
+		.OnMouseButtonDoubleClick(this, &SFolderFootprintTab::OnFolderRowDoubleClicked);
+
+	return ConstructedFolderListView.ToSharedRef();
+}
+
+TSharedRef<SListView<TSharedPtr<FFolderFootprintEntry>>> SFolderFootprintTab::ConstructClassListView()
+{
+	ConstructedClassListView =
+		SNew(SListView<TSharedPtr<FFolderFootprintEntry>>)
+		.ItemHeight(24.0f)
+		.ListItemsSource(&ClassItemsArray)
+		.OnGenerateRow(this, &SFolderFootprintTab::OnGenerateRowForFootprint);
+
+	return ConstructedClassListView.ToSharedRef();
+}
+
+TSharedRef<ITableRow> SFolderFootprintTab::OnGenerateRowForFootprint(TSharedPtr<FFolderFootprintEntry> EntryToDisplay, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	if (!EntryToDisplay.IsValid() || !Footprint.IsValid())
+	{
+		return SNew(STableRow<TSharedPtr<FFolderFootprintEntry>>, OwnerTable);
+	}
+
+	// Share of the whole root, from green for nothing to red for everything
+	const float FootprintFraction = Footprint->GetTotalBytes() > 0 ? static_cast<float>(static_cast<double>(EntryToDisplay->TotalBytes) / Footprint->GetTotalBytes()) : 0.0f;
+	const FLinearColor HeatColor = FLinearColor::LerpUsingHSV(FLinearColor::Green, FLinearColor::Red, FootprintFraction);
+
+	const FString SizeText = FText::AsMemory(EntryToDisplay->TotalBytes).ToString() + TEXT("  (") + FString::FromInt(EntryToDisplay->NumPackages) + TEXT(" packages)");
+
+	TSharedRef<STableRow<TSharedPtr<FFolderFootprintEntry>>> ListViewRowWidget =
+	SNew(STableRow<TSharedPtr<FFolderFootprintEntry>>, OwnerTable)
+	.Padding(FMargin(2.0f))
+	[
+		SNew(SHorizontalBox)
+
+		// 1st Slot for the folder or class name
+		+SHorizontalBox::Slot()
+		.FillWidth(0.5f)
+		.VAlign(EVerticalAlignment::VAlign_Center)
+		[
+			SNew(STextBlock)
+			.Text(FText::FromName(EntryToDisplay->Name))
+			.ToolTipText(FText::FromString(TEXT("Own files: ") + FText::AsMemory(EntryToDisplay->OwnBytes).ToString()))
+		]
+
+		// 2nd Slot for the heat bar
+		+SHorizontalBox::Slot()
+		.FillWidth(0.25f)
+		.VAlign(EVerticalAlignment::VAlign_Center)
+		.Padding(5.0f, 0.0f)
+		[
+			SNew(SProgressBar)
+			.Percent(FootprintFraction)
+			.FillColorAndOpacity(HeatColor)
+		]
+
+		// 3rd Slot for the size
+		+SHorizontalBox::Slot()
+		.FillWidth(0.25f)
+		.VAlign(EVerticalAlignment::VAlign_Center)
+		[
+			SNew(STextBlock)
+			.Text(FText::FromString(SizeText))
+			.Justification(ETextJustify::Right)
+		]
+	];
+
+	return ListViewRowWidget;
+}
+
+void SFolderFootprintTab::OnFolderRowDoubleClicked(TSharedPtr<FFolderFootprintEntry> ClickedEntry)
+{
+	if (ClickedEntry.IsValid())
+	{
+		FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+		SuperManagerModule.SyncContentBrowserToFolder(ClickedEntry->Name.ToString());
+	}
+}
+
+TSharedRef<STextBlock> SFolderFootprintTab::ConstructListTitle(const FString& TextContent)
+{
+	FSlateFontInfo ListTitleFont = FCoreStyle::Get().GetFontStyle(FName("EmbossedText"));
+	ListTitleFont.Size = 15;
+
+	TSharedRef<STextBlock> ConstructedTextBlock =
+		SNew(STextBlock)
+		.Text(FText::FromString(TextContent))
+		.Font(ListTitleFont);
+
+	return ConstructedTextBlock;
+}
+
+TSharedRef<SButton> SFolderFootprintTab::ConstructRefreshButton()
+{
+	TSharedRef<SButton> RefreshButton =
+		SNew(SButton)
+		.Text(FText::FromString(TEXT("Refresh")))
+		.IsEnabled_Lambda([this]() { return !bIsComputing; })
+		.OnClicked(this, &SFolderFootprintTab::OnRefreshButtonClicked);
+
+	return RefreshButton;
+}
+
+FReply SFolderFootprintTab::OnRefreshButtonClicked()
+{
+	RequestFootprint(true);
+	return FReply::Handled();
+}
+
+FText SFolderFootprintTab::GetSummaryText() const
+{
+	if (bIsComputing)
+	{
+		return FText::FromString(TEXT("Measuring ") + RootFolder + TEXT("..."));
+	}
+
+	if (!Footprint.IsValid())
+	{
+		return FText::GetEmpty();
+	}
+
+	return FText::FromString(FString::Printf(TEXT("%s: %s in %d files, measured %s in %.2fs"),
+		*Footprint->GetRootPath(),
+		*FText::AsMemory(Footprint->GetTotalBytes()).ToString(),
+		Footprint->GetNumFiles(),
+		*Footprint->GetComputedAt().ToString(TEXT("%Y-%m-%d %H:%M:%S")),
+		Footprint->GetComputeSeconds()));
+}
+
+void SFolderFootprintTab::RequestFootprint(bool bForceRefresh)
+{
+	bIsComputing = true;
+
+	TWeakPtr<SFolderFootprintTab> WeakFootprintTab = SharedThis(this);
+
+	FSuperManagerModule& SuperManagerModule = FModuleManager::LoadModuleChecked<FSuperManagerModule>(TEXT("SuperManager"));
+	SuperManagerModule.RequestFolderFootprint(RootFolder, bForceRefresh, [WeakFootprintTab](TSharedRef<const FFolderFootprint, ESPMode::ThreadSafe> ReadyFootprint)
+	{
+		// The tab may have been closed while the walk was running
+		if (TSharedPtr<SFolderFootprintTab> FootprintTab = WeakFootprintTab.Pin())
+		{
+			FootprintTab->OnFootprintReady(ReadyFootprint);
+		}
+	});
+}
+
+void SFolderFootprintTab::OnFootprintReady(TSharedRef<const FFolderFootprint, ESPMode::ThreadSafe> ReadyFootprint)
+{
+	bIsComputing = false;
+	Footprint = ReadyFootprint;
+
+	FolderItemsArray.Reset(Footprint->GetFolders().Num());
+	for (const FFolderFootprintEntry& FolderEntry : Footprint->GetFolders())
+	{
+		FolderItemsArray.Add(MakeShared<FFolderFootprintEntry>(FolderEntry));
+	}
+
+	ClassItemsArray.Reset(Footprint->GetClasses().Num());
+	for (const FFolderFootprintEntry& ClassEntry : Footprint->GetClasses())
+	{
+		ClassItemsArray.Add(MakeShared<FFolderFootprintEntry>(ClassEntry));
+	}
+
+	if (ConstructedFolderListView.IsValid())
+	{
+		ConstructedFolderListView->RequestListRefresh();
+	}
+
+	if (ConstructedClassListView.IsValid())
+	{
+		ConstructedClassListView->RequestListRefresh();
+	}
+}
@@ -8,6 +8,8 @@
 #include "AssetRegistryModule.h"
 #include "AssetToolsModule.h"
 #include "SlateWidgets/AdvancedDeletionWidget.h"
+#include "SlateWidgets/AssetListModel.h"
+#include "SlateWidgets/FolderFootprintWidget.h"
 #include "CustomStyle/SuperManagerStyle.h"
 #include "LevelEditor.h"
 #include "Engine/Selection.h"
@@ -15,15 +17,34 @@
 #include "CustomUICommands/SuperManagerUICommands.h"
 #include "SceneOutlinerModule.h"
 #include "CustomWorldOutliner/OutlinerSelectionColumn.h"
+#include "AssetAnalysis/AssetReferenceIndex.h"
+#include "AssetAnalysis/UnusedAssetsScanner.h"
+#include "AssetAnalysis/AssetReachabilityAnalysis.h"
+#include "AssetAnalysis/ContentAnalysis.h"
+#include "AssetActions/RedirectorFixup.h"
+#include "AssetActions/FastAssetDeletion.h"
+#include "AssetAnalysis/FolderFootprint.h"
+#include "AssetAnalysis/DeletionPlan.h"
+#include "AssetAnalysis/ExternalPackageAnalysis.h"
+#include "Async/Async.h"
 
 #define LOCTEXT_NAMESPACE "FSuperManagerModule"
 
 void FSuperManagerModule::StartupModule()
 {
+	// Commandlets only use the analysis side of the plugin
+	if (IsRunningCommandlet())
+	{
+		return;
+	}
+
+	UnusedAssetsTracker.Initialize();
+
 	FSuperManagerStyle::InitializeIcons();
 
 	InitContentBrowserMenuExtension();
 	RegisterAdvancedDeletionTab();
+	RegisterFolderFootprintTab();
 
 	FSuperManagerUICommands::Register();
 	InitCustomUICommands();
@@ -36,8 +57,16 @@ void FSuperManagerModule::StartupModule()
 
 void FSuperManagerModule::ShutdownModule()
 {
+	UnusedAssetsTracker.Shutdown();
+
+	if (IsRunningCommandlet())
+	{
+		return;
+	}
+
 	UnregisterSceneOutlinerColumnExtension();
 	FSuperManagerUICommands::Unregister();
+	UnregisterFolderFootprintTab();
 	UnregisterAdvancedDeletionTab();
 	FSuperManagerStyle::Shutdown();
 }
@@ -63,47 +92,78 @@ bool FSuperManagerModule::DeleteMultipleAssetsForAssetList(const TArray<FAssetDa
 	return false;
 }
 
-void FSuperManagerModule::ListUnusedAssetsForAssetList(const TArray<TSharedPtr<FAssetData>>& AssetsDataToFilter, TArray<TSharedPtr<FAssetData>>& OutUnusedAssetsData)
+void FSuperManagerModule::ListUnusedAssetsForAssetList(const FAssetListModel& AssetListModel, const TArray<TSharedPtr<FAssetListItem>>& AssetItemsToFilter, TArray<TSharedPtr<FAssetListItem>>& OutUnusedAssetItems)
 {
-	OutUnusedAssetsData.Empty();
+	OutUnusedAssetItems.Empty();
 
-	for (const TSharedPtr<FAssetData>& AssetData : AssetsDataToFilter)
+	for (const TSharedPtr<FAssetListItem>& AssetItem : AssetItemsToFilter)
 	{
-		TArray<FString> AssetReferences = UEditorAssetLibrary::FindPackageReferencersForAsset(AssetData->ObjectPath.ToString());
-		if (AssetReferences.Num() == 0)
+		if (UnusedAssetsTracker.IsPackageUnused(AssetListModel.GetPackageName(AssetItem->Index)))
 		{
-			OutUnusedAssetsData.Add(AssetData);
+			OutUnusedAssetItems.Add(AssetItem);
 		}
 	}
 }
 
-void FSuperManagerModule::ListSameNameAssetsForAssetList(const TArray<TSharedPtr<FAssetData>>& AssetsDataToFilter, TArray<TSharedPtr<FAssetData>>& OutSameNameAssetsData)
+TSharedRef<FUnusedAssetsScanner, ESPMode::ThreadSafe> FSuperManagerModule::StartUnusedAssetsScanForAssetList(const FAssetListModel& AssetListModel, const TArray<TSharedPtr<FAssetListItem>>& AssetItemsToFilter)
 {
-	OutSameNameAssetsData.Empty();
+	// The scanner only ever sees package names, the list model stays on the game thread
+	TArray<FName> PackageNamesToScan;
+	PackageNamesToScan.Reserve(AssetItemsToFilter.Num());
 
-	TMultiMap<FString, TSharedPtr<FAssetData>> AssetsMap;
-	for (const TSharedPtr<FAssetData>& AssetData : AssetsDataToFilter)
+	for (const TSharedPtr<FAssetListItem>& AssetItem : AssetItemsToFilter)
 	{
-		AssetsMap.Emplace(AssetData->AssetName.ToString(), AssetData);
+		PackageNamesToScan.Add(AssetListModel.GetPackageName(AssetItem->Index));
 	}
 
-	TArray<FString> MapKeys;
-	AssetsMap.GetKeys(MapKeys);
+	TSharedRef<FUnusedAssetsScanner, ESPMode::ThreadSafe> Scanner = MakeShared<FUnusedAssetsScanner, ESPMode::ThreadSafe>(MoveTemp(PackageNamesToScan), UnusedAssetsTracker.GetReferenceIndexIfBuilt());
+	Scanner->Start();
+
+	return Scanner;
+}
+
+bool FSuperManagerModule::ListUnreachableAssetsForAssetList(const FAssetListModel& AssetListModel, const TArray<TSharedPtr<FAssetListItem>>& AssetItemsToFilter, TArray<TSharedPtr<FAssetListItem>>& OutUnreachableAssetItems)
+{
+	OutUnreachableAssetItems.Empty();
 
-	for (const FString& Key : MapKeys)
+	TSharedPtr<FAssetReferenceIndex, ESPMode::ThreadSafe> ReferenceIndex = GetAssetReferenceIndex();
+	if (!ReferenceIndex.IsValid())
 	{
-		TArray<TSharedPtr<FAssetData>> AssetsDataWithSameNameArray;
-		AssetsMap.MultiFind(Key, AssetsDataWithSameNameArray);
+		return false;
+	}
 
-		if (AssetsDataWithSameNameArray.Num() > 1)
+	FAssetReachabilityAnalysis ReachabilityAnalysis(ReferenceIndex.ToSharedRef());
+	ReachabilityAnalysis.Run();
+
+	for (const TSharedPtr<FAssetListItem>& AssetItem : AssetItemsToFilter)
+	{
+		if (!ReachabilityAnalysis.IsPackageReachable(AssetListModel.GetPackageName(AssetItem->Index)))
 		{
-			for (const TSharedPtr<FAssetData>& AssetData : AssetsDataWithSameNameArray)
-			{
-				if (AssetData.IsValid())
-				{
-					OutSameNameAssetsData.AddUnique(AssetData);
-				}
-			}
+			OutUnreachableAssetItems.Add(AssetItem);
+		}
+	}
+
+	return true;
+}
+
+void FSuperManagerModule::ListSameNameAssetsForAssetList(const FAssetListModel& AssetListModel, const TArray<TSharedPtr<FAssetListItem>>& AssetItemsToFilter, TArray<TSharedPtr<FAssetListItem>>& OutSameNameAssetItems)
+{
+	OutSameNameAssetItems.Empty();
+
+	// Count every name first, then keep the items whose name is shared, in list order
+	TMap<FName, int32> AssetNameCounts;
+	AssetNameCounts.Reserve(AssetItemsToFilter.Num());
+
+	for (const TSharedPtr<FAssetListItem>& AssetItem : AssetItemsToFilter)
+	{
+		++AssetNameCounts.FindOrAdd(AssetListModel.GetAssetName(AssetItem->Index));
+	}
+
+	for (const TSharedPtr<FAssetListItem>& AssetItem : AssetItemsToFilter)
+	{
+		if (AssetNameCounts.FindChecked(AssetListModel.GetAssetName(AssetItem->Index)) > 1)
+		{
+			OutSameNameAssetItems.Add(AssetItem);
 		}
 	}
 }
@@ -115,6 +175,36 @@ void FSuperManagerModule::SyncContentBrowserToClickedAssetForAssetList(const FSt
 	UEditorAssetLibrary::SyncBrowserToObjects(AssetsPathToSync);
 }
 
+void FSuperManagerModule::PlanDeletion(const TArray<FAssetData>& AssetsDataToDelete)
+{
+	FDeletionPlan DeletionPlan;
+	DeletionPlan.Build(AssetsDataToDelete);
+
+	const FString PlanFilePath = FDeletionPlan::MakeDefaultFilePath();
+	const bool bIsPlanSaved = DeletionPlan.SaveToFile(PlanFilePath);
+
+	DebugHeader::PrintLog(TEXT("Deletion plan: ") + DeletionPlan.GetSummary());
+
+	FString Message = TEXT("Dry run, nothing was deleted\n\n") + DeletionPlan.GetSummary();
+	if (!DeletionPlan.HasCookedSizes())
+	{
+		Message += TEXT("\n\nSet a cooked asset registry in the Super Manager settings to estimate cooked sizes");
+	}
+	Message += bIsPlanSaved ? TEXT("\n\nFull plan written to ") + PlanFilePath : TEXT("\n\nFailed to write the plan to ") + PlanFilePath;
+
+	DebugHeader::ShowMsgDialog(EAppMsgType::Ok, Message, false);
+}
+
+TSharedPtr<FAssetReferenceIndex, ESPMode::ThreadSafe> FSuperManagerModule::GetAssetReferenceIndex()
+{
+	return UnusedAssetsTracker.GetReferenceIndexIfBuilt();
+}
+
+void FSuperManagerModule::InvalidateAssetReferenceIndex()
+{
+	UnusedAssetsTracker.InvalidateReferenceIndex();
+}
+
 bool FSuperManagerModule::CheckIsActorSelectionLocked(AActor* ActorToProcess)
 {
 	if (!ActorToProcess)
@@ -181,6 +271,23 @@ void FSuperManagerModule::AddContentBrowserMenuEntry(FMenuBuilder& MenuBuilder)
 		FExecuteAction::CreateRaw(this, &FSuperManagerModule::OnDeleteUnusedAssetsButtonClicked)
 	);
 
+	// Delete unreachable assets
+	MenuBuilder.AddMenuEntry
+	(
+		FText::FromString(TEXT("Delete unreachable assets")),
+		FText::FromString(TEXT("Delete every asset under folder that can't be reached from maps, primary assets or always cooked folders")),
+		FSlateIcon(FSuperManagerStyle::GetStyleSetName(), "ContentBrowser.DeleteUnusedAssets"),
+		FExecuteAction::CreateRaw(this, &FSuperManagerModule::OnDeleteUnreachableAssetsButtonClicked)
+	);
+
+	// Plan unused assets deletion
+	MenuBuilder.AddMenuEntry(
+		FText::FromString(TEXT("Plan unused assets deletion (dry run)")),
+		FText::FromString(TEXT("Estimate what deleting the unused assets under folder would reclaim, without deleting or loading anything")),
+		FSlateIcon(FSuperManagerStyle::GetStyleSetName(), "ContentBrowser.DeleteUnusedAssets"),
+		FExecuteAction::CreateRaw(this, &FSuperManagerModule::OnPlanUnusedAssetsDeletionButtonClicked)
+	);
+
 	// Delete empty folders
 	MenuBuilder.AddMenuEntry(
 		FText::FromString(TEXT("Delete empty folders")),
@@ -189,6 +296,14 @@ void FSuperManagerModule::AddContentBrowserMenuEntry(FMenuBuilder& MenuBuilder)
 		FExecuteAction::CreateRaw(this, &FSuperManagerModule::OnDeleteEmptyFoldersButtonClicked)
 	);
 
+	// Delete orphaned external packages
+	MenuBuilder.AddMenuEntry(
+		FText::FromString(TEXT("Delete orphaned external packages")),
+		FText::FromString(TEXT("Delete __ExternalActors__ and __ExternalObjects__ packages whose level is gone or doesn't own them any more, in the whole project")),
+		FSlateIcon(FSuperManagerStyle::GetStyleSetName(), "ContentBrowser.DeleteEmptyFolders"),
+		FExecuteAction::CreateRaw(this, &FSuperManagerModule::OnDeleteOrphanedExternalPackagesButtonClicked)
+	);
+
 	// Advanced Deletion
 	MenuBuilder.AddMenuEntry(
 		FText::FromString(TEXT("Advanced Deletion")),
@@ -196,6 +311,14 @@ void FSuperManagerModule::AddContentBrowserMenuEntry(FMenuBuilder& MenuBuilder)
 		FSlateIcon(FSuperManagerStyle::GetStyleSetName(), "ContentBrowser.AdvancedDeletion"),
 		FExecuteAction::CreateRaw(this, &FSuperManagerModule::OnAdvancedDeletionButtonClicked)
 	);
+
+	// Folder Footprint
+	MenuBuilder.AddMenuEntry(
+		FText::FromString(TEXT("Folder footprint")),
+		FText::FromString(TEXT("Show which folders and asset classes take the most disk space")),
+		FSlateIcon(FSuperManagerStyle::GetStyleSetName(), "ContentBrowser.FolderFootprint"),
+		FExecuteAction::CreateRaw(this, &FSuperManagerModule::OnFolderFootprintButtonClicked)
+	);
 }
 
 void FSuperManagerModule::OnDeleteUnusedAssetsButtonClicked()
@@ -206,65 +329,96 @@ void FSuperManagerModule::OnDeleteUnusedAssetsButtonClicked()
 		return;
 	}
 
-	if (FoldersPathSelectedArray.Num() > 1)
+	FixUpRedirectors(FoldersPathSelectedArray);
+
+	// The tracker already knows which packages are unused, every selected folder is served by one registry query
+	TArray<FAssetData> UnusedAssetsDataArray;
+	UnusedAssetsTracker.GetUnusedAssetsUnderFolders(FoldersPathSelectedArray, UnusedAssetsDataArray);
+
+	if (UnusedAssetsDataArray.Num() > 0)
 	{
-		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("You can only do this to one folder"));
-		return;
-	}
+		EAppReturnType::Type ConfirmResult = DebugHeader::ShowMsgDialog(EAppMsgType::YesNo, TEXT("A total of ") + FString::FromInt(UnusedAssetsDataArray.Num())
+			+ TEXT(" unused assets found under ") + FString::FromInt(FoldersPathSelectedArray.Num()) + TEXT(" selected folders.\nWould you like to procceed?"));
+		if (ConfirmResult == EAppReturnType::No)
+		{
+			return;
+		}
 
-	TArray<FString> AssetsPathNameArray = UEditorAssetLibrary::ListAssets(FoldersPathSelectedArray[0]);
-	if (AssetsPathNameArray.Num() == 0)
+		DeleteUnreferencedAssets(UnusedAssetsDataArray);
+
+		EAppReturnType::Type DeleteEmptyFoldersResult = DebugHeader::ShowMsgDialog(EAppMsgType::YesNo, TEXT("Would you like to delete the empty folders?"), false);
+		if (DeleteEmptyFoldersResult == EAppReturnType::Yes)
+		{
+			OnDeleteEmptyFoldersButtonClicked();
+		}
+	}
+	else
 	{
-		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("No asset found under selected folder"));
-		return;
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("No unused asset found under selected folders"));
 	}
+}
 
-	EAppReturnType::Type ConfirmResult = DebugHeader::ShowMsgDialog(EAppMsgType::YesNo, TEXT("A total of ") + FString::FromInt(AssetsPathNameArray.Num()) + TEXT(" assets found.\nWould you like to procceed?"));
-	if (ConfirmResult == EAppReturnType::No)
+void FSuperManagerModule::OnPlanUnusedAssetsDeletionButtonClicked()
+{
+	TArray<FAssetData> UnusedAssetsDataArray;
+	UnusedAssetsTracker.GetUnusedAssetsUnderFolders(FoldersPathSelectedArray, UnusedAssetsDataArray);
+
+	if (UnusedAssetsDataArray.Num() == 0)
 	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("No unused asset found under selected folders"), false);
 		return;
 	}
 
-	FixUpRedirectors();
+	PlanDeletion(UnusedAssetsDataArray);
+}
 
-	TArray<FAssetData> UnusedAssetsDataArray;
-	for (const FString& AssetPathName : AssetsPathNameArray)
+void FSuperManagerModule::OnDeleteUnreachableAssetsButtonClicked()
+{
+	if (AdvancedDeletionTab.IsValid())
 	{
-		// Don't touch the root folder
-		if (AssetPathName.Contains(TEXT("Developers")) || AssetPathName.Contains(TEXT("Collections")) 
-			|| AssetPathName.Contains(TEXT("__ExternalActors__")) || AssetPathName.Contains(TEXT("__ExternalObjects__")))
-		{
-			continue;
-		}
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("Please close Advanced Deletion Tab before this operation"));
+		return;
+	}
 
-		// Verify if the asset exists
-		if (!UEditorAssetLibrary::DoesAssetExist(AssetPathName))
-		{
-			continue;
-		}
+	FixUpRedirectors(FoldersPathSelectedArray);
 
-		TArray<FString> AssetReferencesArray = UEditorAssetLibrary::FindPackageReferencersForAsset(AssetPathName);
-		if (AssetReferencesArray.Num() == 0)
-		{
-			const FAssetData UnusedAssetData = UEditorAssetLibrary::FindAssetData(AssetPathName);
-			UnusedAssetsDataArray.Add(UnusedAssetData);
-		}
+	// The whole graph is walked, building the index here would stall the editor
+	TSharedPtr<FAssetReferenceIndex, ESPMode::ThreadSafe> ReferenceIndex = GetAssetReferenceIndex();
+	if (!ReferenceIndex.IsValid())
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("Asset references are still being indexed, please try again in a moment"));
+		return;
 	}
 
-	if (UnusedAssetsDataArray.Num() > 0)
+	TArray<FAssetData> AssetsDataArray;
+	FContentAnalysis::GatherAssetsUnderFolders(FoldersPathSelectedArray, AssetsDataArray);
+	if (AssetsDataArray.Num() == 0)
 	{
-		ObjectTools::DeleteAssets(UnusedAssetsDataArray);
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("No asset found under selected folders"));
+		return;
+	}
 
-		EAppReturnType::Type DeleteEmptyFoldersResult = DebugHeader::ShowMsgDialog(EAppMsgType::YesNo, TEXT("Would you like to delete the empty folders?"), false);
-		if (ConfirmResult == EAppReturnType::Yes)
-		{
-			OnDeleteEmptyFoldersButtonClicked();
-		}
+	// One mark pass over the whole graph, then sweep the selected folders
+	FAssetReachabilityAnalysis ReachabilityAnalysis(ReferenceIndex.ToSharedRef());
+	ReachabilityAnalysis.Run();
+
+	TArray<FAssetData> UnreachableAssetsDataArray;
+	FContentAnalysis::FindUnreachableAssets(AssetsDataArray, ReachabilityAnalysis, UnreachableAssetsDataArray);
+
+	if (UnreachableAssetsDataArray.Num() == 0)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("No unreachable asset found under selected folders"));
+		return;
 	}
-	else
+
+	EAppReturnType::Type ConfirmResult = DebugHeader::ShowMsgDialog(EAppMsgType::YesNo, FString::FromInt(UnreachableAssetsDataArray.Num()) + TEXT(" of ") + FString::FromInt(AssetsDataArray.Num())
+		+ TEXT(" assets can't be reached from any map, primary asset or always cooked folder.\nWould you like to proceed?"));
+	if (ConfirmResult == EAppReturnType::No)
 	{
-		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("No unused asset found under selected folder"));
+		return;
 	}
+
+	DeleteUnreferencedAssets(UnreachableAssetsDataArray);
 }
 
 void FSuperManagerModule::OnDeleteEmptyFoldersButtonClicked()
@@ -275,130 +429,177 @@ void FSuperManagerModule::OnDeleteEmptyFoldersButtonClicked()
 		return;
 	}
 
-	FixUpRedirectors();
+	FixUpRedirectors(FoldersPathSelectedArray);
 
-	FString EmptyFoldersPathsNames;
 	TArray<FString> EmptyFoldersPathsArray;
+	FContentAnalysis::FindEmptyFolders(FoldersPathSelectedArray, EmptyFoldersPathsArray);
 
-	// First check the subfolders
-	for (const FString& FolderPathSelected : FoldersPathSelectedArray)
+	if (EmptyFoldersPathsArray.Num() == 0)
 	{
-		TArray<FString> SubfoldersPathArray = UEditorAssetLibrary::ListAssets(FolderPathSelected, true, true);
-		for (const FString& FolderPath : SubfoldersPathArray)
-		{
-			// Don't touch the root folder
-			if (FolderPath.Contains(TEXT("Developers")) || FolderPath.Contains(TEXT("Collections"))
-				|| FolderPath.Contains(TEXT("__ExternalActors__")) || FolderPath.Contains(TEXT("__ExternalObjects__")))
-			{
-				continue;
-			}
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("No empty folders found"));
+		return;
+	}
 
-			if (UEditorAssetLibrary::DoesDirectoryExist(FolderPath) && !UEditorAssetLibrary::DoesDirectoryHaveAssets(FolderPath) && !EmptyFoldersPathsArray.Contains(FolderPath))
-			{
-				EmptyFoldersPathsArray.Add(FolderPath);
+	FString EmptyFoldersPathsNames;
+	for (const FString& EmptyFolderPath : EmptyFoldersPathsArray)
+	{
+		EmptyFoldersPathsNames.Append(TEXT("\n"));
+		EmptyFoldersPathsNames.Append(EmptyFolderPath);
+	}
 
-				EmptyFoldersPathsNames.Append(TEXT("\n"));
-				EmptyFoldersPathsNames.Append(FolderPath);
-			}
-		}
+	EAppReturnType::Type ConfirmResult = DebugHeader::ShowMsgDialog(EAppMsgType::OkCancel, TEXT("Empty folders found ") + FString::FromInt(EmptyFoldersPathsArray.Num()) + TEXT(":") + EmptyFoldersPathsNames + TEXT("\n\nWould you like to delete all?"), false);
+	if (ConfirmResult == EAppReturnType::Cancel)
+	{
+		return;
 	}
 
-	// Second check the selected folders
-	for (const FString& FolderPathSelected : FoldersPathSelectedArray)
+	const double DeleteStartTime = FPlatformTime::Seconds();
+
+	TArray<FString> DeletedFoldersPathsArray;
+	FContentAnalysis::DeleteEmptyFolders(EmptyFoldersPathsArray, DeletedFoldersPathsArray);
+
+	const double DeleteSeconds = FPlatformTime::Seconds() - DeleteStartTime;
+	const double FoldersPerSecond = DeleteSeconds > 0.0 ? DeletedFoldersPathsArray.Num() / DeleteSeconds : 0.0;
+
+	if (DeletedFoldersPathsArray.Num() != EmptyFoldersPathsArray.Num())
 	{
-		bool bAreAllSubfoldersEmpty = true;
-		TArray<FString> SubfoldersPathArray = UEditorAssetLibrary::ListAssets(FolderPathSelected, false, true);
-		for (const FString& FolderPath : SubfoldersPathArray)
+		const TSet<FString> DeletedFoldersPathsSet(DeletedFoldersPathsArray);
+		for (const FString& EmptyFolderPath : EmptyFoldersPathsArray)
 		{
-			if (!UEditorAssetLibrary::DoesDirectoryExist(FolderPath) || !EmptyFoldersPathsArray.Contains(FolderPath))
+			if (!DeletedFoldersPathsSet.Contains(EmptyFolderPath))
 			{
-				bAreAllSubfoldersEmpty = false;
-				break;
+				DebugHeader::Print(TEXT("Failed to delete ") + EmptyFolderPath, FColor::Red);
 			}
 		}
+	}
 
-		// Don't touch the root folder
-		if (FolderPathSelected.Contains(TEXT("Developers")) || FolderPathSelected.Contains(TEXT("Collections"))
-			|| FolderPathSelected.Contains(TEXT("__ExternalActors__")) || FolderPathSelected.Contains(TEXT("__ExternalObjects__")))
-		{
-			continue;
-		}
+	// Notify status
+	const int32 FoldersDeletedCounter = DeletedFoldersPathsArray.Num();
+	FString ResultMessage = TEXT("Successfully deleted ") + FString::FromInt(FoldersDeletedCounter) + TEXT(" folders")
+		+ FString::Printf(TEXT(" in %.2fs (%.0f folders/sec)"), DeleteSeconds, FoldersPerSecond);
+	if (FoldersDeletedCounter != EmptyFoldersPathsArray.Num())
+	{
+		ResultMessage.Append(TEXT("\nCouldn't delete ") + FString::FromInt(EmptyFoldersPathsArray.Num() - FoldersDeletedCounter) + TEXT(" folders"));
+	}
 
-		if (UEditorAssetLibrary::DoesDirectoryExist(FolderPathSelected) && bAreAllSubfoldersEmpty && !EmptyFoldersPathsArray.Contains(FolderPathSelected))
-		{
-			EmptyFoldersPathsArray.Add(FolderPathSelected);
+	DebugHeader::ShowNotifyInfo(ResultMessage);
+}
 
-			EmptyFoldersPathsNames.Append(TEXT("\n"));
-			EmptyFoldersPathsNames.Append(FolderPathSelected);
-		}
+void FSuperManagerModule::OnDeleteOrphanedExternalPackagesButtonClicked()
+{
+	if (AdvancedDeletionTab.IsValid())
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("Please close Advanced Deletion Tab before this operation"));
+		return;
 	}
 
-	if (EmptyFoldersPathsArray.Num() == 0)
+	FExternalPackageAnalysis ExternalPackageAnalysis;
+	if (!ExternalPackageAnalysis.Run())
 	{
-		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("No empty folders found"));
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("The Asset Registry is still discovering assets, please try again once it has finished"));
 		return;
 	}
 
-	EAppReturnType::Type ConfirmResult = DebugHeader::ShowMsgDialog(EAppMsgType::OkCancel, TEXT("Empty folders found ") + FString::FromInt(EmptyFoldersPathsArray.Num()) + TEXT(":") + EmptyFoldersPathsNames + TEXT("\n\nWould you like to delete all?"), false);
-	if (ConfirmResult == EAppReturnType::Cancel)
+	const TArray<FOrphanedExternalPackage>& OrphanedPackages = ExternalPackageAnalysis.GetOrphanedPackages();
+	if (OrphanedPackages.Num() == 0)
 	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, FString::Printf(TEXT("No orphaned package among %d external packages of %d levels"),
+			ExternalPackageAnalysis.GetNumExternalPackages(), ExternalPackageAnalysis.GetNumLevels()), false);
 		return;
 	}
 
-	uint32 FoldersDeletedCounter = 0;
-	for (const FString& EmptyFolderPath : EmptyFoldersPathsArray)
+	for (const FOrphanedExternalPackage& OrphanedPackage : OrphanedPackages)
 	{
-		if (UEditorAssetLibrary::DeleteDirectory(EmptyFolderPath))
-		{
-			++FoldersDeletedCounter;
-		}
-		else
-		{
-			DebugHeader::Print(TEXT("Failed to delete ") + EmptyFolderPath, FColor::Red);
-		}
+		DebugHeader::PrintLog(FString::Printf(TEXT("Orphaned external package %s (%s)"),
+			*OrphanedPackage.AssetData.PackageName.ToString(), FExternalPackageAnalysis::LexToString(OrphanedPackage.Issue)));
 	}
 
-	// Notify status
-	FString ResultMessage = TEXT("Successfully deleted ") + FString::FromInt(FoldersDeletedCounter) + TEXT(" folders");
-	if (FoldersDeletedCounter != EmptyFoldersPathsArray.Num())
+	EAppReturnType::Type ConfirmResult = DebugHeader::ShowMsgDialog(EAppMsgType::YesNo, FString::Printf(TEXT("%d of %d external packages no longer belong to any of the %d levels, see the log for the list.\nWould you like to proceed?"),
+		OrphanedPackages.Num(), ExternalPackageAnalysis.GetNumExternalPackages(), ExternalPackageAnalysis.GetNumLevels()));
+	if (ConfirmResult == EAppReturnType::No)
 	{
-		ResultMessage.Append(TEXT("\nCouldn't delete ") + FString::FromInt(EmptyFoldersPathsArray.Num() - FoldersDeletedCounter) + TEXT(" folders"));
+		return;
 	}
 
-	DebugHeader::ShowNotifyInfo(ResultMessage);
+	TArray<FAssetData> OrphanedAssetsData;
+	ExternalPackageAnalysis.GetOrphanedAssetsData(OrphanedAssetsData);
+
+	if (OrphanedAssetsData.Num() == 0)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("The levels of these packages exist on disk, nothing was deleted"), false);
+		return;
+	}
+
+	// External packages belong to levels, the editor's deletion handles them and their source control state properly
+	const int32 NumOfAssetsDeleted = ObjectTools::DeleteAssets(OrphanedAssetsData, true);
+	if (NumOfAssetsDeleted > 0)
+	{
+		DebugHeader::ShowNotifyInfo(FString::Printf(TEXT("Successfully deleted %d orphaned external packages"), NumOfAssetsDeleted));
+	}
 }
 
 void FSuperManagerModule::OnAdvancedDeletionButtonClicked()
 {
-	FixUpRedirectors();
+	FixUpRedirectors(FoldersPathSelectedArray);
 	FGlobalTabmanager::Get()->TryInvokeTab(FName("AdvancedDeletion"));
 }
 
-void FSuperManagerModule::FixUpRedirectors()
+void FSuperManagerModule::OnFolderFootprintButtonClicked()
 {
-	TArray<UObjectRedirector*> RedirectorsToFixArray;
+	FolderFootprintRootPath = FoldersPathSelectedArray[0];
 
-	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
+	// An open tab is pointed at the new folder instead of being focused as is
+	if (FolderFootprintTab.IsValid())
+	{
+		FolderFootprintTab->SetContent(SNew(SFolderFootprintTab).RootFolder(FolderFootprintRootPath));
+	}
 
-	FARFilter Filter;
-	Filter.bRecursivePaths = true;
-	Filter.PackagePaths.Emplace("/Game");
-	Filter.ClassNames.Emplace("ObjectRedirector");
+	FGlobalTabmanager::Get()->TryInvokeTab(FName("FolderFootprint"));
+}
 
-	TArray<FAssetData> OutRedirectors;
+void FSuperManagerModule::FixUpRedirectors(const TArray<FString>& FolderPaths)
+{
+	TArray<FAssetData> RedirectorsData;
+	FRedirectorFixup::FindRedirectorsForFolders(FolderPaths, RedirectorsData);
 
-	AssetRegistryModule.Get().GetAssets(Filter, OutRedirectors);
+	const FRedirectorFixupStats FixupStats = FRedirectorFixup::FixUpRedirectors(RedirectorsData);
+	if (FixupStats.NumRedirectorsFixed == 0)
+	{
+		return;
+	}
+
+	// Fixed up referencers now point to new packages
+	InvalidateAssetReferenceIndex();
+
+	DebugHeader::ShowNotifyInfo(FString::Printf(TEXT("Fixed up %d redirectors, %d packages in %.2fs (%.0f packages/sec)\nPeak memory %.0f MiB"),
+		FixupStats.NumRedirectorsFixed, FixupStats.NumPackagesLoaded, FixupStats.Seconds, FixupStats.GetPackagesPerSecond(), FixupStats.PeakUsedPhysical / (1024.0 * 1024.0)));
+}
+
+int32 FSuperManagerModule::DeleteUnreferencedAssets(const TArray<FAssetData>& AssetsDataToDelete)
+{
+	const FFastAssetDeletionStats DeletionStats = FFastAssetDeletion::DeleteAssets(AssetsDataToDelete);
 
-	for (const FAssetData& RedirectorData : OutRedirectors)
+	for (const FName FailedPackageName : DeletionStats.FailedPackageNames)
 	{
-		if (UObjectRedirector* RedirectorToFix = Cast<UObjectRedirector>(RedirectorData.GetAsset()))
-		{
-			RedirectorsToFixArray.Add(RedirectorToFix);
-		}
+		DebugHeader::Print(TEXT("Failed to delete ") + FailedPackageName.ToString(), FColor::Red);
+	}
+
+	// Notify status
+	FString ResultMessage = FString::Printf(TEXT("Successfully deleted %d assets, %d packages (%s) without loading in %.2fs (%.0f packages/sec)"),
+		DeletionStats.NumAssetsDeleted, DeletionStats.NumPackagesDeleted, *FText::AsMemory(DeletionStats.NumBytesDeleted).ToString(),
+		DeletionStats.Seconds, DeletionStats.GetPackagesPerSecond());
+	if (DeletionStats.NumAssetsFallenBack > 0)
+	{
+		ResultMessage.Append(FString::Printf(TEXT("\n%d loaded or referenced assets went through the editor's deletion"), DeletionStats.NumAssetsFallenBack));
+	}
+	if (DeletionStats.FailedPackageNames.Num() > 0)
+	{
+		ResultMessage.Append(FString::Printf(TEXT("\nCouldn't delete %d packages"), DeletionStats.FailedPackageNames.Num()));
 	}
 
-	FAssetToolsModule& AssetToolsModule = FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools"));
-	AssetToolsModule.Get().FixupReferencers(RedirectorsToFixArray);
+	DebugHeader::ShowNotifyInfo(ResultMessage);
+
+	return DeletionStats.NumAssetsDeleted;
 }
 
 void FSuperManagerModule::RegisterAdvancedDeletionTab()
@@ -431,8 +632,8 @@ TSharedRef<SDockTab> FSuperManagerModule::OnSpawnAdvancedDeletionTab(const FSpaw
 		.TabRole(ETabRole::NomadTab)
 		[
 			SNew(SAdvancedDeletionTab)
-			.AssetsDataToStoreArray(GetAllAssetsDataUnderSelectedFolder())
-			.CurrentSelectedFolder(FoldersPathSelectedArray[0])
+			.AssetListModel(GetAssetListModelForSelectedFolders())
+			.SelectedFolders(FoldersPathSelectedArray)
 		];
 
 	AdvancedDeletionTab->SetOnTabClosed(SDockTab::FOnTabClosedCallback::CreateRaw(this, &FSuperManagerModule::OnAdvancedDeletionTabClosed));
@@ -448,31 +649,98 @@ void FSuperManagerModule::OnAdvancedDeletionTabClosed(TSharedRef<SDockTab> TabTo
 	}
 }
 
-TArray<TSharedPtr<FAssetData>> FSuperManagerModule::GetAllAssetsDataUnderSelectedFolder()
+TSharedRef<FAssetListModel> FSuperManagerModule::GetAssetListModelForSelectedFolders()
+{
+	const double GatherStartTime = FPlatformTime::Seconds();
+
+	TArray<FAssetData> AssetsDataArray;
+	FContentAnalysis::GatherAssetsUnderFolders(FoldersPathSelectedArray, AssetsDataArray);
+
+	// The model only keeps columns, the gathered array is dropped right after
+	TSharedRef<FAssetListModel> AssetListModel = MakeShared<FAssetListModel>();
+	AssetListModel->Append(AssetsDataArray);
+
+	DebugHeader::PrintLog(FString::Printf(TEXT("Advanced Deletion gathered %d assets under %d folders in %.3fs"),
+		AssetListModel->Num(), FoldersPathSelectedArray.Num(), FPlatformTime::Seconds() - GatherStartTime));
+
+	return AssetListModel;
+}
+
+void FSuperManagerModule::RegisterFolderFootprintTab()
+{
+	FGlobalTabmanager::Get()->RegisterNomadTabSpawner(
+		FName("FolderFootprint"),
+		FOnSpawnTab::CreateRaw(this, &FSuperManagerModule::OnSpawnFolderFootprintTab))
+			.SetDisplayName(FText::FromString(TEXT("Folder Footprint")))
+			.SetIcon(FSlateIcon(FSuperManagerStyle::GetStyleSetName(), "ContentBrowser.FolderFootprint")
+	);
+}
+
+void FSuperManagerModule::UnregisterFolderFootprintTab()
 {
-	TArray<TSharedPtr<FAssetData>> AvailableAssetsDataArray;
+	FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(FName("FolderFootprint"));
+}
+
+TSharedRef<SDockTab> FSuperManagerModule::OnSpawnFolderFootprintTab(const FSpawnTabArgs& SpawnTabArgs)
+{
+	if (FolderFootprintRootPath.IsEmpty())
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("You must right click on a folder from Content Browser"));
+		return
+			SNew(SDockTab)
+			.TabRole(ETabRole::NomadTab);
+	}
+
+	FolderFootprintTab =
+		SNew(SDockTab)
+		.TabRole(ETabRole::NomadTab)
+		[
+			SNew(SFolderFootprintTab)
+			.RootFolder(FolderFootprintRootPath)
+		];
+
+	FolderFootprintTab->SetOnTabClosed(SDockTab::FOnTabClosedCallback::CreateLambda([this](TSharedRef<SDockTab> TabToClose)
+	{
+		FolderFootprintTab.Reset();
+	}));
+
+	return FolderFootprintTab.ToSharedRef();
+}
 
-	TArray<FString> AssetsPathNameArray = UEditorAssetLibrary::ListAssets(FoldersPathSelectedArray[0]);
-	for (const FString& AssetPathName : AssetsPathNameArray)
+void FSuperManagerModule::RequestFolderFootprint(const FString& RootPath, bool bForceRefresh, TFunction<void(TSharedRef<const FFolderFootprint, ESPMode::ThreadSafe>)> OnFootprintReady)
+{
+	if (!bForceRefresh)
 	{
-		// Don't touch the root folder
-		if (AssetPathName.Contains(TEXT("Developers")) || AssetPathName.Contains(TEXT("Collections"))
-			|| AssetPathName.Contains(TEXT("__ExternalActors__")) || AssetPathName.Contains(TEXT("__ExternalObjects__")))
+		if (const TSharedPtr<const FFolderFootprint, ESPMode::ThreadSafe>* CachedFootprint = FolderFootprintCache.Find(RootPath))
 		{
-			continue;
+			OnFootprintReady(CachedFootprint->ToSharedRef());
+			return;
 		}
+	}
+
+	// The walk only touches the file system and the registry, results are cached and handed out on the game thread
+	Async(EAsyncExecution::ThreadPool, [RootPath, OnFootprintReady = MoveTemp(OnFootprintReady)]() mutable
+	{
+		TSharedRef<const FFolderFootprint, ESPMode::ThreadSafe> ComputedFootprint = FFolderFootprint::Compute(RootPath);
 
-		// Verify if the asset exists
-		if (!UEditorAssetLibrary::DoesAssetExist(AssetPathName))
+		AsyncTask(ENamedThreads::GameThread, [RootPath, ComputedFootprint, OnFootprintReady = MoveTemp(OnFootprintReady)]()
 		{
-			continue;
-		}
+			if (FSuperManagerModule* SuperManagerModule = FModuleManager::GetModulePtr<FSuperManagerModule>(TEXT("SuperManager")))
+			{
+				SuperManagerModule->FolderFootprintCache.Add(RootPath, ComputedFootprint);
+				OnFootprintReady(ComputedFootprint);
+			}
+		});
+	});
+}
 
-		const FAssetData Data = UEditorAssetLibrary::FindAssetData(AssetPathName);
-		AvailableAssetsDataArray.Add(MakeShared<FAssetData>(Data));
-	}
+void FSuperManagerModule::SyncContentBrowserToFolder(const FString& FolderPathToSync)
+{
+	TArray<FString> FoldersPathToSync;
+	FoldersPathToSync.Add(FolderPathToSync);
 
-	return AvailableAssetsDataArray;
+	FContentBrowserModule& ContentBrowserModule = FModuleManager::LoadModuleChecked<FContentBrowserModule>(TEXT("ContentBrowser"));
+	ContentBrowserModule.Get().SyncBrowserToFolders(FoldersPathToSync);
 }
 
 void FSuperManagerModule::InitLevelEditorMenuExtension()
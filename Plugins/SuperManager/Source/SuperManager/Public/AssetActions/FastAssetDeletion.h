@@ -0,0 +1,48 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Outcome of one fast deletion, for the notification */
+struct FFastAssetDeletionStats
+{
+	/** Both paths together */
+	int32 NumAssetsDeleted = 0;
+
+	/** Packages whose files were deleted without loading them */
+	int32 NumPackagesDeleted = 0;
+
+	/** Assets handed to ObjectTools::DeleteAssets */
+	int32 NumAssetsFallenBack = 0;
+
+	/** Package files and their .uexp / .ubulk sidecars */
+	int64 NumBytesDeleted = 0;
+
+	/** Packages whose files couldn't be deleted, read only or locked */
+	TArray<FName> FailedPackageNames;
+
+	int32 NumChunks = 0;
+	double Seconds = 0.0;
+
+	FORCEINLINE double GetPackagesPerSecond() const { return Seconds > 0.0 ? NumPackagesDeleted / Seconds : 0.0; }
+};
+
+/**
+ * Deletion for assets the registry has already shown to be unreferenced, without ever loading them.
+ * Package files are deleted in chunks of FastDeletionChunkSize and the Asset Registry is told about each chunk with a single rescan.
+ * Anything loaded, referenced from outside the set or under source control goes through ObjectTools::DeleteAssets instead,
+ * which does its own reference checks and confirmation.
+ */
+class FFastAssetDeletion
+{
+public:
+	static FFastAssetDeletionStats DeleteAssets(const TArray<FAssetData>& AssetsDataToDelete);
+
+private:
+	/** Splits the packages into the ones safe to delete from disk and the assets that need the editor's own deletion */
+	static void PartitionAssets(const TArray<FAssetData>& AssetsDataToDelete, TArray<FName>& OutFastPackageNames, TArray<FAssetData>& OutFallbackAssetsData);
+
+	/** Deletes the files of one chunk, OutDeletedFilenames are the ones the registry has to rescan */
+	static void DeletePackageFiles(TArrayView<const FName> PackageNames, TArray<FString>& OutDeletedFilenames, FFastAssetDeletionStats& InOutStats);
+};
@@ -54,6 +54,4 @@ private:
 		{ UNiagaraSystem::StaticClass(), TEXT("NS_") },
 		{ UNiagaraEmitter::StaticClass(), TEXT("NE_") }
 	};
-
-	void FixUpRedirectors();
 };
@@ -0,0 +1,43 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Outcome of one fixup, for the notification */
+struct FRedirectorFixupStats
+{
+	int32 NumRedirectorsFixed = 0;
+	int32 NumPackagesLoaded = 0;
+	int32 NumBatches = 0;
+	double Seconds = 0.0;
+
+	/** Highest physical memory sampled while a batch was loaded */
+	uint64 PeakUsedPhysical = 0;
+
+	FORCEINLINE double GetPackagesPerSecond() const { return Seconds > 0.0 ? NumPackagesLoaded / Seconds : 0.0; }
+};
+
+/**
+ * Redirector fixup shared by the Content Browser actions, the Advanced Deletion tab and the Quick Asset Actions.
+ * The scoped finders only look at registry data, nothing is loaded unless a redirector is actually relevant:
+ * one inside the scope, one pointing into it, or one referenced from it.
+ */
+class FRedirectorFixup
+{
+public:
+	/** Scoped Search */
+	static void FindRedirectorsForFolders(const TArray<FString>& FolderPaths, TArray<FAssetData>& OutRedirectorsData);
+	static void FindRedirectorsForPackages(const TArray<FName>& PackageNames, TArray<FAssetData>& OutRedirectorsData);
+
+	/**
+	 * Fixes up the redirectors in batches of at most RedirectorFixupBatchSize packages, redirectors sharing referencers are kept together.
+	 * Every referencer is checked out behind a single prompt first, nothing is fixed if the user declines.
+	 * A batch is loaded asynchronously, fixed up, then the packages it loaded are unloaded before the next one is loaded.
+	 * Batches shrink whenever one grows memory past RedirectorFixupMemoryBudgetMB and grow back while they stay well under it.
+	 */
+	static FRedirectorFixupStats FixUpRedirectors(const TArray<FAssetData>& RedirectorsData);
+
+private:
+	static void FindRedirectorsInScope(TFunctionRef<bool(FName PackageName)> IsPackageInScope, TArray<FAssetData>& OutRedirectorsData);
+};
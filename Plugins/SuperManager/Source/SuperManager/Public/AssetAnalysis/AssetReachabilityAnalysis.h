@@ -0,0 +1,40 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Forward Declarations */
+class FAssetReferenceIndex;
+
+/**
+ * Mark and sweep over the package dependency graph.
+ * Roots are maps, primary assets and the packages they manage, configured always-cook / always-reachable folders,
+ * default game classes and everything outside /Game. Any package not reached from them is dead content, including islands of
+ * assets that only reference each other.
+ */
+class FAssetReachabilityAnalysis
+{
+public:
+	/** Constructor */
+	FAssetReachabilityAnalysis(TSharedRef<FAssetReferenceIndex, ESPMode::ThreadSafe> InReferenceIndex);
+
+	/** Walk the graph once from the root set, O(V+E) */
+	void Run();
+
+	bool IsPackageReachable(FName PackageName) const;
+
+	FORCEINLINE int32 GetNumRoots() const { return NumRoots; }
+	FORCEINLINE int32 GetNumReachable() const { return NumReachable; }
+
+private:
+	void GatherRootPackages(TArray<int32>& OutRootIndices) const;
+
+	TSharedRef<FAssetReferenceIndex, ESPMode::ThreadSafe> ReferenceIndex;
+
+	/** One bit per package slot of the reference index */
+	TBitArray<> ReachableFlags;
+
+	int32 NumRoots = 0;
+	int32 NumReachable = 0;
+};
@@ -0,0 +1,93 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Forward Declarations */
+struct FAssetData;
+
+/** What the registry told us about the assets inside an indexed package */
+enum class EIndexedPackageFlags : uint8
+{
+	None				= 0,
+	ContainsMap			= 1 << 0,
+	ContainsPrimaryAsset	= 1 << 1,
+	ContainsAssets		= 1 << 2
+};
+ENUM_CLASS_FLAGS(EIndexedPackageFlags);
+
+/**
+ * Reverse dependency index over the Asset Registry package graph.
+ * Built in a single pass over every package dependency, then answers referencer queries in O(1).
+ * The outgoing edges are kept in compact offset/index arrays for graph walks.
+ * Can be saved to disk as a snapshot keyed by project package file timestamps and the engine version, so later builds only requery changed packages.
+ * Single packages can be requeried in place, their new edges are patched over the compact arrays.
+ */
+class FAssetReferenceIndex
+{
+public:
+	/** Walk the Asset Registry dependency graph once and count the referencers of every package, reusing unchanged packages of the snapshot */
+	void Build(const FAssetReferenceIndex* Snapshot = nullptr);
+	void Reset();
+
+	/** Requery one package, every package whose referencer count or flags may have changed is appended to OutAffectedPackageIndices */
+	void UpdatePackage(FName PackageName, TArray<int32>& OutAffectedPackageIndices);
+
+	/** Snapshot */
+	bool SaveToFile(const FString& Filename) const;
+	bool LoadFromFile(const FString& Filename);
+	static FString GetSnapshotFilePath();
+
+	FORCEINLINE int32 GetNumRevalidatedPackages() const { return NumRevalidatedPackages; }
+
+	FORCEINLINE bool IsBuilt() const { return bIsBuilt; }
+	FORCEINLINE int32 Num() const { return PackageNames.Num(); }
+
+	int32 GetReferencerCount(FName PackageName) const;
+	FORCEINLINE bool IsPackageUnused(FName PackageName) const { return GetReferencerCount(PackageName) == 0; }
+
+	/** Index based access for graph walks */
+	int32 FindPackageIndex(FName PackageName) const;
+	FORCEINLINE FName GetPackageName(int32 PackageIndex) const { return PackageNames[PackageIndex]; }
+	FORCEINLINE EIndexedPackageFlags GetPackageFlags(int32 PackageIndex) const { return PackageFlags[PackageIndex]; }
+	FORCEINLINE int32 GetPackageReferencerCount(int32 PackageIndex) const { return ReferencerCounts[PackageIndex]; }
+	TConstArrayView<int32> GetDependencies(int32 PackageIndex) const;
+
+private:
+	int32 FindOrAddPackage(FName PackageName);
+
+	void Save(FArchive& Ar) const;
+	bool Load(FArchive& Ar);
+
+	/** Offsets never go down and every edge points at a package, so a damaged file can't index out of bounds */
+	bool HasValidEdges() const;
+
+	/** Fold the patched edges back into the offset/index arrays */
+	void CompactDependencies();
+
+	static EIndexedPackageFlags GetFlagsForAsset(const FAssetData& AssetData);
+
+	/** One directory walk over the content roots inside the project, engine content only changes with the engine version */
+	static void GatherProjectPackageFileTimestamps(TMap<FName, FDateTime>& OutPackageFileTimestamps, TArray<FString>& OutProjectRootPaths);
+
+	/** Package name -> slot in the parallel arrays below */
+	TMap<FName, int32> PackageIndexMap;
+
+	TArray<FName> PackageNames;
+	TArray<int32> ReferencerCounts;
+	TArray<EIndexedPackageFlags> PackageFlags;
+
+	/** Modification time of the package file when its dependencies were queried, zero when it had no file */
+	TArray<FDateTime> PackageTimestamps;
+
+	/** Outgoing edges of package i are DependencyIndices[DependencyOffsets[i] .. DependencyOffsets[i + 1]) */
+	TArray<int32> DependencyOffsets;
+	TArray<int32> DependencyIndices;
+
+	/** Edges of packages updated since the last build, these take precedence over the arrays above */
+	TMap<int32, TArray<int32>> PatchedDependencies;
+
+	bool bIsBuilt = false;
+	int32 NumRevalidatedPackages = 0;
+};
@@ -0,0 +1,43 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Forward Declarations */
+class FAssetReferenceIndex;
+class FAssetReachabilityAnalysis;
+
+/**
+ * UI free content analyses and batch operations shared by the Content Browser actions, the Advanced Deletion tab and the audit commandlet.
+ */
+class FContentAnalysis
+{
+public:
+	/** Assets */
+	static void GatherFoldersUnderFolder(const FString& FolderPath, TArray<FName>& OutFolderPaths);
+	static void GatherAssetsUnderFolder(const FString& FolderPath, TArray<FAssetData>& OutAssetsData);
+	static void GatherAssetsUnderFolders(const TArray<FString>& FolderPaths, TArray<FAssetData>& OutAssetsData);
+
+	/** Selected folders without the excluded ones and without those already under another selected folder */
+	static void CollapseNestedFolders(const TArray<FString>& FolderPaths, TArray<FString>& OutRootFolderPaths);
+	static void FindUnusedAssets(const TArray<FAssetData>& AssetsDataToFilter, const FAssetReferenceIndex& ReferenceIndex, TArray<FAssetData>& OutUnusedAssetsData);
+	static void FindUnreachableAssets(const TArray<FAssetData>& AssetsDataToFilter, const FAssetReachabilityAnalysis& ReachabilityAnalysis, TArray<FAssetData>& OutUnreachableAssetsData);
+	static void FindSameNameAssets(const TArray<FAssetData>& AssetsDataToFilter, TArray<FAssetData>& OutSameNameAssetsData);
+
+	/** Referencers, for when no reference index is built yet */
+	static void QueryUnusedPackages(TConstArrayView<FName> PackageNames, TArray<bool>& OutIsUnused);
+	static void QueryUnusedPackagesInParallel(TConstArrayView<FName> PackageNames, TArray<bool>& OutIsUnused);
+
+	/** Folders, an empty folder is listed after all of its subfolders */
+	static void FindEmptyFolders(const TArray<FString>& FolderPathsToSearch, TArray<FString>& OutEmptyFolderPaths);
+
+	/** Deepest first, the registry is only told about the topmost deleted folders once all are gone */
+	static void DeleteEmptyFolders(const TArray<FString>& EmptyFolderPaths, TArray<FString>& OutDeletedFolderPaths);
+
+	/** Redirectors */
+	static void FindRedirectors(const FString& FolderPath, TArray<FAssetData>& OutRedirectorsData);
+
+	/** Package Files, payloads saved next to a package share its base filename, e.g. .uexp and .ubulk */
+	static TConstArrayView<const TCHAR*> GetPackageSidecarExtensions();
+};
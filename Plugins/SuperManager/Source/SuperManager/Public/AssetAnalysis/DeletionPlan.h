@@ -0,0 +1,65 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Forward Declarations */
+class FJsonObject;
+
+/**
+ * Dry run of a deletion: what would go, which folders would be left empty, which redirectors are involved and how many bytes come back.
+ * Built from registry metadata and file stats only, nothing is loaded.
+ * Cooked sizes come from the development asset registry set in USuperManagerSettings, they are unknown without one.
+ */
+class FDeletionPlan
+{
+public:
+	void Build(const TArray<FAssetData>& AssetsDataToDelete);
+
+	/** Export */
+	TSharedRef<FJsonObject> ToJson() const;
+	bool SaveToFile(const FString& Filename) const;
+	static FString MakeDefaultFilePath();
+
+	/** One paragraph for dialogs and logs */
+	FString GetSummary() const;
+
+	FORCEINLINE int32 GetNumAssets() const { return AssetObjectPaths.Num(); }
+	FORCEINLINE int32 GetNumPackages() const { return Packages.Num(); }
+	FORCEINLINE const TArray<FString>& GetFoldersBecomingEmpty() const { return FoldersBecomingEmpty; }
+	FORCEINLINE const TArray<FString>& GetRedirectorObjectPaths() const { return RedirectorObjectPaths; }
+	FORCEINLINE int64 GetDiskBytes() const { return DiskBytes; }
+	FORCEINLINE bool HasCookedSizes() const { return CookedBytes != INDEX_NONE; }
+	FORCEINLINE int64 GetCookedBytes() const { return CookedBytes; }
+
+private:
+	void GatherFoldersBecomingEmpty();
+	void GatherCookedSizes();
+
+	struct FPlannedPackage
+	{
+		FName PackageName;
+		int64 DiskBytes = 0;
+
+		/** INDEX_NONE when the package isn't in the cooked registry */
+		int64 CookedBytes = INDEX_NONE;
+	};
+
+	TArray<FString> AssetObjectPaths;
+	TArray<FPlannedPackage> Packages;
+
+	/** Folders only the planned packages keep alive, each listed after all of its subfolders */
+	TArray<FString> FoldersBecomingEmpty;
+
+	/** Redirectors inside the plan, pointing into it or referenced from it */
+	TArray<FString> RedirectorObjectPaths;
+
+	int64 DiskBytes = 0;
+
+	/** INDEX_NONE without a cooked registry */
+	int64 CookedBytes = INDEX_NONE;
+	FString CookedRegistryPath;
+
+	FDateTime PlannedAt;
+};
@@ -0,0 +1,64 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetData.h"
+
+/** Why an external package no longer belongs to anything */
+enum class EExternalPackageIssue : uint8
+{
+	/** No level is left where its folder or its outer says it belongs */
+	MissingLevel,
+
+	/** Its outer is another level than the one whose external folder it sits in */
+	LevelMismatch,
+
+	/** The package holds something other than an object of its level, e.g. a stray asset */
+	NotLevelObject
+};
+
+/** One per asset, a package holding several objects shows up once for each */
+struct FOrphanedExternalPackage
+{
+	FAssetData AssetData;
+
+	/** Level owning the folder the package sits in, NAME_None when there is none */
+	FName FolderLevelPackageName;
+
+	EExternalPackageIssue Issue = EExternalPackageIssue::MissingLevel;
+};
+
+/**
+ * One File Per Actor bookkeeping: every level's __ExternalActors__ / __ExternalObjects__ folders are indexed from a single
+ * registry query, then every package under them is checked against the level it sits under and the level its outer names.
+ * The usual exclusion rules skip these folders on purpose, this analysis is the only one that looks inside them.
+ */
+class FExternalPackageAnalysis
+{
+public:
+	/**
+	 * Two registry queries over every mount point, nothing is loaded.
+	 * Refused while the registry is still discovering assets, a level it hasn't found yet would orphan all of its packages.
+	 */
+	bool Run();
+
+	FORCEINLINE const TArray<FOrphanedExternalPackage>& GetOrphanedPackages() const { return OrphanedPackages; }
+
+	/** Checks the disk again first, packages whose level exists there after all are left out */
+	void GetOrphanedAssetsData(TArray<FAssetData>& OutAssetsData) const;
+
+	FORCEINLINE int32 GetNumLevels() const { return NumLevels; }
+	FORCEINLINE int32 GetNumExternalPackages() const { return NumExternalPackages; }
+
+	static const TCHAR* LexToString(EExternalPackageIssue Issue);
+
+	/** /Game/Maps/MyMap gives /Game/<ExternalFolderName>/Maps/MyMap, empty for a name without a mount point */
+	static FString MakeExternalFolderPath(const FString& LevelPackageName, const TCHAR* ExternalFolderName);
+
+private:
+	TArray<FOrphanedExternalPackage> OrphanedPackages;
+
+	int32 NumLevels = 0;
+	int32 NumExternalPackages = 0;
+};
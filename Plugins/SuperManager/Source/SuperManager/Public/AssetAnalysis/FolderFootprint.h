@@ -0,0 +1,51 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Bytes on disk of one folder, subfolders included, or of one asset class */
+struct FFolderFootprintEntry
+{
+	FName Name;
+	int64 TotalBytes = 0;
+
+	/** Files directly in the folder, equal to TotalBytes for classes */
+	int64 OwnBytes = 0;
+
+	int32 NumPackages = 0;
+};
+
+/**
+ * Disk footprint of a content folder, from a single stat walk of its directory on disk.
+ * Every file counts towards its folders, .uexp and .ubulk payloads count towards their package's class.
+ * Immutable once computed, so it can be cached and shared with the UI.
+ */
+class FFolderFootprint
+{
+public:
+	/** Walks the disk and reads the registry's on disk assets, safe on any thread */
+	static TSharedRef<const FFolderFootprint, ESPMode::ThreadSafe> Compute(const FString& RootPath);
+
+	FORCEINLINE const FString& GetRootPath() const { return RootPath; }
+	FORCEINLINE int64 GetTotalBytes() const { return TotalBytes; }
+	FORCEINLINE int32 GetNumFiles() const { return NumFiles; }
+
+	/** Both sorted from the largest down */
+	FORCEINLINE const TArray<FFolderFootprintEntry>& GetFolders() const { return Folders; }
+	FORCEINLINE const TArray<FFolderFootprintEntry>& GetClasses() const { return Classes; }
+
+	FORCEINLINE const FDateTime& GetComputedAt() const { return ComputedAt; }
+	FORCEINLINE double GetComputeSeconds() const { return ComputeSeconds; }
+
+private:
+	FString RootPath;
+	int64 TotalBytes = 0;
+	int32 NumFiles = 0;
+
+	TArray<FFolderFootprintEntry> Folders;
+	TArray<FFolderFootprintEntry> Classes;
+
+	FDateTime ComputedAt;
+	double ComputeSeconds = 0.0;
+};
@@ -0,0 +1,34 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Folders SuperManager never scans or deletes, compiled once into hashed sets of FName path components.
+ * A path is excluded when one of its folders has an excluded name, or when it lies under an excluded folder.
+ * Both checks are one hash lookup per path component.
+ */
+class FPathExclusionRules
+{
+public:
+	/** Rules compiled from USuperManagerSettings */
+	static const FPathExclusionRules& Get();
+	static void Recompile();
+
+	void Compile(const TArray<FName>& InExcludedFolderNames, const TArray<FString>& InExcludedFolderPaths);
+
+	/** Every component of FolderPath is a folder */
+	bool IsFolderExcluded(FStringView FolderPath) const;
+
+	/** Accepts package names and object paths, only the folders leading to the package are checked */
+	bool IsPackageExcluded(FStringView PackageName) const;
+
+private:
+	TSet<FName> ExcludedFolderNames;
+
+	/** Full paths without trailing slash, e.g. /Game/Cinematics/Takes */
+	TSet<FName> ExcludedFolderPaths;
+
+	static TUniquePtr<FPathExclusionRules> CompiledRules;
+};
@@ -0,0 +1,55 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+/** Forward Declarations */
+class FAssetReferenceIndex;
+
+/**
+ * Filters a list of packages for unused ones on a background thread.
+ * Uses the shared reference index when one is built, otherwise fans the referencer queries of each batch out over worker threads, nothing waits on a full graph walk.
+ * Results are produced in batches that the game thread drains while the scan is still running.
+ */
+class FUnusedAssetsScanner : public TSharedFromThis<FUnusedAssetsScanner, ESPMode::ThreadSafe>
+{
+public:
+	/** Constructor */
+	FUnusedAssetsScanner(TArray<FName>&& InPackageNamesToScan, TSharedPtr<FAssetReferenceIndex, ESPMode::ThreadSafe> InReferenceIndex);
+
+	void Start();
+	void Cancel();
+
+	/** Game thread only: moves the indices of every unused package found since the last call */
+	void DrainResults(TArray<int32>& OutUnusedIndices);
+
+	FORCEINLINE bool IsCancelled() const { return bIsCancelled; }
+	FORCEINLINE bool IsComplete() const { return bIsComplete; }
+
+	FORCEINLINE int32 GetNumToScan() const { return PackageNamesToScan.Num(); }
+	FORCEINLINE int32 GetNumScanned() const { return NumScanned; }
+	float GetProgress() const;
+	double GetAssetsPerSecond() const;
+
+private:
+	void Run();
+
+	/** Enough packages to keep every worker busy, few enough that the first results show up right away */
+	static constexpr int32 BatchSize = 1024;
+
+	const TArray<FName> PackageNamesToScan;
+
+	const TSharedPtr<FAssetReferenceIndex, ESPMode::ThreadSafe> ReferenceIndex;
+
+	FCriticalSection PendingResultsLock;
+	TArray<int32> PendingResults;
+
+	std::atomic<int32> NumScanned;
+	std::atomic<bool> bIsCancelled;
+	std::atomic<bool> bIsComplete;
+
+	double ScanStartTime = 0.0;
+	std::atomic<double> ScanEndTime;
+};
@@ -0,0 +1,89 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "Containers/Ticker.h"
+
+/** Forward Declarations */
+class FAssetReferenceIndex;
+
+DECLARE_MULTICAST_DELEGATE(FOnReferenceIndexReady);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnUnusedAssetsChanged, const TArray<FName>& /*ChangedPackageNames*/);
+
+/**
+ * Long lived editor service that owns the shared reference index and keeps the set of unused packages up to date.
+ * The index is only ever built on the thread pool, queries made before it is ready fall back to the registry.
+ * Asset Registry events only mark packages dirty, they are requeried together on the next tick.
+ * The index is copied before it is patched whenever a background task still holds it.
+ * Game thread only.
+ */
+class FUnusedAssetsTracker
+{
+public:
+	void Initialize();
+	void Shutdown();
+
+	/** Reference Index, null until a background build has been published */
+	TSharedPtr<FAssetReferenceIndex, ESPMode::ThreadSafe> GetReferenceIndexIfBuilt();
+	FORCEINLINE bool IsBuildingReferenceIndex() const { return BuildTask.IsValid(); }
+
+	void InvalidateReferenceIndex();
+	void SaveReferenceIndexSnapshot();
+
+	/** Broadcast whenever a newly built index is published */
+	FORCEINLINE FOnReferenceIndexReady& OnReferenceIndexReady() { return ReferenceIndexReadyEvent; }
+
+	/** Unused Packages */
+	bool IsPackageUnused(FName PackageName);
+	int32 GetNumUnusedPackagesUnderFolder(const FString& FolderPath);
+	void GetUnusedAssetsUnderFolders(const TArray<FString>& FolderPaths, TArray<FAssetData>& OutUnusedAssetsData);
+
+	/** Broadcast after pending registry changes have been applied, with every package whose referencers or unused state may have changed */
+	FORCEINLINE FOnUnusedAssetsChanged& OnUnusedAssetsChanged() { return UnusedAssetsChangedEvent; }
+
+private:
+	/** Asset Registry Events */
+	void OnAssetAdded(const FAssetData& AssetData);
+	void OnAssetRemoved(const FAssetData& AssetData);
+	void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+	void OnAssetUpdated(const FAssetData& AssetData);
+	void OnAssetRegistryFilesLoaded();
+
+	void MarkPackageDirty(FName PackageName);
+	bool OnTick(float DeltaTime);
+	void ApplyPendingChanges();
+
+	/** Starts from the in-memory snapshot when there is one, otherwise from the previous session's file */
+	void StartReferenceIndexBuild();
+	void OnReferenceIndexBuilt(TSharedPtr<FAssetReferenceIndex, ESPMode::ThreadSafe> BuiltReferenceIndex, uint32 BuiltAtGeneration);
+
+	void SetReferenceIndex(TSharedPtr<FAssetReferenceIndex, ESPMode::ThreadSafe> NewReferenceIndex);
+	void RebuildUnusedPackages();
+	void UpdateUnusedState(int32 PackageIndex);
+
+	TSharedPtr<FAssetReferenceIndex, ESPMode::ThreadSafe> ReferenceIndex;
+	uint32 ReferenceIndexGeneration = 0;
+
+	/** Last known index, from disk or before the latest invalidation, only packages changed since are requeried */
+	TSharedPtr<FAssetReferenceIndex, ESPMode::ThreadSafe> ReferenceIndexSnapshot;
+
+	/** Background build, its result is handed back on the game thread */
+	TFuture<void> BuildTask;
+
+	/** Packages touched by registry events since the index was last patched */
+	TSet<FName> DirtyPackageNames;
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	/** Packages that own assets but have no referencers */
+	TSet<FName> UnusedPackageNames;
+
+	/** Unused packages of each folder, without its subfolders, ancestors are merged when a folder is queried */
+	TMap<FName, TSet<FName>> UnusedPackagesPerFolder;
+
+	FOnReferenceIndexReady ReferenceIndexReadyEvent;
+	FOnUnusedAssetsChanged UnusedAssetsChangedEvent;
+
+	bool bIsInitialized = false;
+};
@@ -0,0 +1,48 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SuperManagerAuditCommandlet.generated.h"
+
+/** Forward Declarations */
+class FJsonObject;
+class FJsonValue;
+
+/**
+ * Runs SuperManager's content analyses without any UI and writes a JSON report.
+ *
+ * UnrealEditor-Cmd <Project> -run=SuperManagerAudit -nullrhi [-Root=/Game] [-Report=<File>] [-Phases=unused,unreachable,samename,emptyfolders,redirectors,externalpackages] [-Benchmark] [-PlanUnused] [-CleanupExternal]
+ *
+ * -Benchmark also times the serial and the parallel referencer queries against each other.
+ * -PlanUnused adds a dry run deletion plan of the unused assets, with the bytes deleting them would reclaim.
+ * -CleanupExternal deletes the orphaned external packages found by the externalpackages phase, the other phases never modify content.
+ */
+UCLASS()
+class SUPERMANAGER_API USuperManagerAuditCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	/** Constructor */
+	USuperManagerAuditCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	/** Times one analysis phase and records it in the report */
+	void RunPhase(const FString& PhaseName, TFunctionRef<void(int32& OutNumProcessed, int32& OutNumFound)> PhaseBody);
+
+	void AddAssetsToReport(const FString& FieldName, const TArray<FAssetData>& AssetsData);
+	void AddPathsToReport(const FString& FieldName, const TArray<FString>& Paths);
+
+	bool ShouldRunPhase(const FString& PhaseName) const;
+
+	void RunReferencerQueryBenchmark(const TArray<FAssetData>& AssetsData);
+
+	TArray<FString> PhasesToRun;
+
+	TSharedPtr<FJsonObject> ReportObject;
+	TArray<TSharedPtr<FJsonValue>> PhaseReports;
+};
@@ -0,0 +1,22 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "SuperManagerBenchmarkAsset.generated.h"
+
+/**
+ * Smallest savable asset with hard references, the benchmark commandlet fills its temp content with these.
+ * Never created outside of the benchmark mount point.
+ */
+UCLASS(NotBlueprintable, HideDropdown)
+class SUPERMANAGER_API USuperManagerBenchmarkAsset : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	/** Saved as package dependencies, that is all the analyses look at */
+	UPROPERTY()
+	TArray<UObject*> References;
+};
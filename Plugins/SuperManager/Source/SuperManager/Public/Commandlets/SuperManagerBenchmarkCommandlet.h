@@ -0,0 +1,57 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SuperManagerBenchmarkCommandlet.generated.h"
+
+/** Forward Declarations */
+class FJsonObject;
+class FJsonValue;
+
+/**
+ * Generates throwaway content trees of increasing size in a temp mount point and times SuperManager's content analyses on each.
+ *
+ * UnrealEditor-Cmd <Project> -run=SuperManagerBenchmark -nullrhi [-Sizes=1000,10000,100000] [-ReferenceDensity=2.0] [-FolderDepth=3] [-FolderFanout=4]
+ *                  [-EmptyFolderRatio=0.1] [-Seed=1234] [-Phases=gather,listmodel,referenceindex,unused,unusedparallel,samename,emptyfolders,deletefolders] [-Report=<File>] [-KeepContent]
+ *
+ * Every phase reports ns/asset, the physical memory it added and the process peak physical memory.
+ * deletefolders is timed per deleted folder instead, its ns/asset is ns/folder.
+ */
+UCLASS()
+class SUPERMANAGER_API USuperManagerBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	/** Constructor */
+	USuperManagerBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	/** Content Generation */
+	bool GenerateContent(const FString& RootPath, int32 NumAssets);
+	void DestroyContent(const FString& RootPath);
+
+	void RunBenchmark(const FString& RootPath, int32 NumAssets);
+
+	/** Times one analysis phase and records it in the report of the current size */
+	void RunPhase(const FString& PhaseName, int32 NumAssets, TFunctionRef<void(int32& OutNumFound)> PhaseBody);
+
+	bool ShouldRunPhase(const FString& PhaseName) const;
+
+	/** Generation Parameters */
+	float ReferenceDensity = 2.0f;
+	int32 FolderDepth = 3;
+	int32 FolderFanout = 4;
+	float EmptyFolderRatio = 0.1f;
+	int32 Seed = 1234;
+
+	TArray<FString> PhasesToRun;
+
+	FString MountContentDir;
+
+	TArray<TSharedPtr<FJsonValue>> PhaseReports;
+};
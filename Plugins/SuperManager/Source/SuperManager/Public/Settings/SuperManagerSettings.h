@@ -0,0 +1,58 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "SuperManagerSettings.generated.h"
+
+/**
+ * Project wide settings for SuperManager, found under Project Settings > Plugins > Super Manager
+ */
+UCLASS(config = Editor, defaultconfig, meta = (DisplayName = "Super Manager"))
+class SUPERMANAGER_API USuperManagerSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	/** Constructor */
+	USuperManagerSettings();
+
+	virtual FName GetCategoryName() const override { return FName("Plugins"); }
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+	/** Reachability */
+	UPROPERTY(config, EditAnywhere, Category = "Reachability", meta = (ContentDir, LongPackageName))
+	TArray<FDirectoryPath> AlwaysReachableFolders;
+
+	UPROPERTY(config, EditAnywhere, Category = "Reachability")
+	bool bTreatDirectoriesToAlwaysCookAsRoots;
+
+	UPROPERTY(config, EditAnywhere, Category = "Reachability")
+	bool bTreatPrimaryAssetsAsRoots;
+
+	/** Exclusions */
+	UPROPERTY(config, EditAnywhere, Category = "Exclusions")
+	TArray<FName> ExcludedFolderNames;
+
+	UPROPERTY(config, EditAnywhere, Category = "Exclusions", meta = (ContentDir, LongPackageName))
+	TArray<FDirectoryPath> ExcludedFolders;
+
+	/** Redirectors */
+	UPROPERTY(config, EditAnywhere, Category = "Redirectors", meta = (ClampMin = "1", UIMin = "1"))
+	int32 RedirectorFixupBatchSize;
+
+	UPROPERTY(config, EditAnywhere, Category = "Redirectors", meta = (ClampMin = "256", UIMin = "256", Units = "Megabytes"))
+	int32 RedirectorFixupMemoryBudgetMB;
+
+	/** Deletion, package files deleted between two Asset Registry updates on the fast path */
+	UPROPERTY(config, EditAnywhere, Category = "Deletion", meta = (ClampMin = "1", UIMin = "1"))
+	int32 FastDeletionChunkSize;
+
+	/** Deletion Planning, a development asset registry from a cook, e.g. Metadata/DevelopmentAssetRegistry.bin */
+	UPROPERTY(config, EditAnywhere, Category = "Deletion Planning", meta = (FilePathFilter = "bin", RelativeToGameDir))
+	FFilePath CookedAssetRegistryFile;
+};
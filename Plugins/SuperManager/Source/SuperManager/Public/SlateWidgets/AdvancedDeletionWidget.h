@@ -3,34 +3,112 @@
 #pragma once
 
 #include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/STableRow.h"
+#include "Widgets/Views/SHeaderRow.h"
+#include "SlateWidgets/AssetListModel.h"
+#include "SlateWidgets/AssetTagFilter.h"
+
+/** Forward Declarations */
+class FUnusedAssetsScanner;
+class SAdvancedDeletionTab;
+class SWrapBox;
+class SEditableTextBox;
+
+/** One visible row of the asset list, the cells are built by the owning tab */
+class SAdvancedDeletionRow : public SMultiColumnTableRow<TSharedPtr<FAssetListItem>>
+{
+	SLATE_BEGIN_ARGS(SAdvancedDeletionRow) { }
+	SLATE_ARGUMENT(TSharedPtr<FAssetListItem>, AssetItem)
+	SLATE_ARGUMENT(TWeakPtr<SAdvancedDeletionTab>, OwnerTab)
+	SLATE_END_ARGS()
+
+public:
+	void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& OwnerTable);
+
+	virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override;
+
+private:
+	TSharedPtr<FAssetListItem> AssetItem;
+	TWeakPtr<SAdvancedDeletionTab> OwnerTab;
+};
 
 class SAdvancedDeletionTab : public SCompoundWidget
 {
 	SLATE_BEGIN_ARGS(SAdvancedDeletionTab) { }
-	SLATE_ARGUMENT(TArray<TSharedPtr<FAssetData>>, AssetsDataToStoreArray)
-	SLATE_ARGUMENT(FString, CurrentSelectedFolder)
+	SLATE_ARGUMENT(TSharedPtr<FAssetListModel>, AssetListModel)
+	SLATE_ARGUMENT(TArray<FString>, SelectedFolders)
 	SLATE_END_ARGS()
 
 public:
 	void Construct(const FArguments& InArgs);
+	virtual ~SAdvancedDeletionTab();
 
 private:
-	TSharedRef<SListView<TSharedPtr<FAssetData>>> ConstructAssetListView();
-	TSharedRef<ITableRow> OnGenerateRowForList(TSharedPtr<FAssetData> AssetDataToDisplay, const TSharedRef<STableViewBase>& OwnerTable);
-	void OnRowWidgetMouseButtonClicked(TSharedPtr<FAssetData> ClickedData);
+	friend class SAdvancedDeletionRow;
+
+	TSharedRef<SListView<TSharedPtr<FAssetListItem>>> ConstructAssetListView();
+	TSharedRef<SHeaderRow> ConstructHeaderRow();
+	TSharedRef<ITableRow> OnGenerateRowForList(TSharedPtr<FAssetListItem> AssetItemToDisplay, const TSharedRef<STableViewBase>& OwnerTable);
+	TSharedRef<SWidget> ConstructCellForColumn(const TSharedPtr<FAssetListItem>& AssetItemToDisplay, const FName& ColumnName);
+	void OnRowWidgetMouseButtonClicked(TSharedPtr<FAssetListItem> ClickedItem);
 	void RefreshAssetListView();
 
-	TSharedRef<SCheckBox> ConstructCheckBox(const TSharedPtr<FAssetData> AssetDataToDisplay);
-	void OnCheckBoxStateChanged(ECheckBoxState NewState, TSharedPtr<FAssetData> AssetData);
+	/** Drops every row the model marks removed, one pass per item array, scroll position and selection are kept */
+	void CompactRemovedAssetItems();
+
+	/** Sorting, compares the model columns of the listed rows, search and facets keep their order */
+	EColumnSortMode::Type GetColumnSortMode(FName ColumnId) const;
+	void OnColumnSortModeChanged(EColumnSortPriority::Type SortPriority, const FName& ColumnId, EColumnSortMode::Type NewSortMode);
+	void SortListedAssetItems();
+
+	/** Search and class facets, narrow the listed rows down to the displayed ones */
+	TSharedRef<SVerticalBox> ConstructSearchBox();
+	void OnSearchTextChanged(const FText& InSearchText);
+	bool DoesAssetItemMatchSearch(const TSharedPtr<FAssetListItem>& AssetItem) const;
+
+	/** Registry tag filter, evaluated over the model's tag columns when committed and applied as part of the search */
+	void OnTagFilterTextCommitted(const FText& InFilterText, ETextCommit::Type CommitType);
+
+	/** One pass that filters by the search and counts the class histogram, bNarrow only goes over the previous matches */
+	void ApplySearch(bool bNarrow);
+	void ApplyClassFacets();
+	void RebuildClassFacets();
+	ECheckBoxState GetClassFacetState(FName AssetClass) const;
+	void OnClassFacetStateChanged(ECheckBoxState NewState, FName AssetClass);
+	FText GetClassFacetText(FName AssetClass) const;
+
+	/** Lists one more row, it only reaches the matched and displayed rows if the search and class facets let it through */
+	void AddListedAssetItem(const TSharedPtr<FAssetListItem>& AssetItem, bool& bOutClassesChanged);
+
+	/** Removes the matching rows from the listed, matched and displayed rows, returns how many listed rows went */
+	int32 RemoveListedAssetItems(TFunctionRef<bool(const TSharedPtr<FAssetListItem>&)> Predicate);
+
+	/** Fills the referencer column of every row, only once the reference index has been built */
+	void UpdateReferencerCounts();
+
+	TSharedRef<SCheckBox> ConstructCheckBox(const TSharedPtr<FAssetListItem> AssetItemToDisplay);
+	ECheckBoxState GetCheckBoxState(TSharedPtr<FAssetListItem> AssetItem) const;
+	void OnCheckBoxStateChanged(ECheckBoxState NewState, TSharedPtr<FAssetListItem> AssetItem);
+
+	/** Selected rows in display order, one pass over the displayed rows */
+	void GetSelectedAssetItems(TArray<TSharedPtr<FAssetListItem>>& OutSelectedItems) const;
+
+	/** Selected rows the search, tag filter or class facets hide, the bulk actions leave them alone */
+	int32 GetNumHiddenSelected() const;
+	FText GetHiddenSelectionText() const;
+	EVisibility GetHiddenSelectionVisibility() const;
 
 	TSharedRef<STextBlock> ConstructTextForRowWidget(const FString& TextContent, const FSlateFontInfo& FontToUse);
 
-	TSharedRef<SButton> ConstructButtonForRowWidget(TSharedPtr<FAssetData> AssetDataToDisplay);
-	FReply OnDeleteButtonClicked(TSharedPtr<FAssetData> ClickedAssetData);
+	TSharedRef<SButton> ConstructButtonForRowWidget(TSharedPtr<FAssetListItem> AssetItemToDisplay);
+	FReply OnDeleteButtonClicked(TSharedPtr<FAssetListItem> ClickedAssetItem);
 
 	TSharedRef<SButton> ConstructDeleteAllButton();
 	FReply OnDeleteAllButtonClicked();
 
+	TSharedRef<SButton> ConstructDryRunButton();
+	FReply OnDryRunButtonClicked();
+
 	TSharedRef<SButton> ConstructSelectAllButton();
 	FReply OnSelectAllButtonClicked();
 
@@ -44,15 +122,67 @@ private:
 	void OnComboBoxSelectionChanged(TSharedPtr<FString> SelectedOption, ESelectInfo::Type InSelectInfo);
 	TSharedRef<STextBlock> ConstructComboBoxHelpText(const FString& TextContent, ETextJustify::Type TextJustify);
 
+	TSharedRef<SHorizontalBox> ConstructScanProgressBox();
+	EVisibility GetScanProgressVisibility() const;
+	TOptional<float> GetScanProgressPercent() const;
+	FText GetScanStatusText() const;
+	FReply OnCancelScanButtonClicked();
+
+	void StartUnusedAssetsScan();
+	void CancelUnusedAssetsScan();
+	EActiveTimerReturnType UpdateUnusedAssetsScan(double InCurrentTime, float InDeltaTime);
+
+	/** Drops listed unused assets that became referenced or were removed and lists the ones that became unused, e.g. after a sync */
+	void OnUnusedAssetsChanged(const TArray<FName>& ChangedPackageNames);
+	bool IsPackageInSelectedFolders(const FString& PackageName) const;
+
+	/** Lists the unreachable assets once the index they need has been built */
+	void OnReferenceIndexReady();
+	void ListUnreachableAssets();
+
 	/** Variables */
-	TSharedPtr<SListView<TSharedPtr<FAssetData>>> ConstructedAssetListView;
-	TArray<TSharedPtr<FAssetData>> StoredAssetsDataArray;
-	TArray<TSharedPtr<FAssetData>> DisplayedAssetsDataArray;
+	TSharedPtr<SListView<TSharedPtr<FAssetListItem>>> ConstructedAssetListView;
 
-	TArray<TSharedPtr<FAssetData>> AssetsDataToDeleteArray;
+	/** Every listed asset, the item arrays below only point into it */
+	TSharedPtr<FAssetListModel> AssetListModel;
+	TArray<TSharedPtr<FAssetListItem>> StoredAssetItemsArray;
 
-	TArray<TSharedRef<SCheckBox>> CheckBoxesArray;
+	/** Rows of the listing condition, then the ones matching the search, then the ones the class facets let through */
+	TArray<TSharedPtr<FAssetListItem>> ListedAssetItemsArray;
+	TArray<TSharedPtr<FAssetListItem>> SearchMatchedAssetItemsArray;
+	TArray<TSharedPtr<FAssetListItem>> DisplayedAssetItemsArray;
+
+	/** Lowercase search text and its whitespace separated tokens, every token has to be in the name, case is ignored */
+	FString SearchText;
+	TArray<FString> SearchTokens;
+
+	/** One bit per model row, only read while the filter isn't empty */
+	FAssetTagFilter TagFilter;
+	TBitArray<> TagFilterMatches;
+	TSharedPtr<SEditableTextBox> TagFilterTextBox;
+
+	/** Search matches per class, shown on the facets, and the classes toggled off */
+	TMap<FName, int32> ClassHistogram;
+	TSet<FName> HiddenClasses;
+	TSharedPtr<SWrapBox> ClassFacetsBox;
+
+	/** Recounted when the displayed rows change or rows are selected, INDEX_NONE marks the count stale */
+	mutable int32 NumHiddenSelected = 0;
+	mutable int32 NumSelectedAtHiddenCount = INDEX_NONE;
+
+	FName SortColumnId;
+	EColumnSortMode::Type SortMode = EColumnSortMode::None;
+
+	/** Folders the tab was opened on, with a trailing slash */
+	TArray<FString> SelectedFolders;
 
 	TArray<TSharedPtr<FString>> ComboBoxSourceItems;
 	TSharedPtr<STextBlock> ComboBoxDisplayTextBlock;
+	FString CurrentListingCondition;
+
+	/** Background unused assets scan, results are streamed into ListedAssetItemsArray */
+	TSharedPtr<FUnusedAssetsScanner, ESPMode::ThreadSafe> UnusedAssetsScanner;
+	TSharedPtr<FActiveTimerHandle> UnusedAssetsScanTimerHandle;
+	TArray<TSharedPtr<FAssetListItem>> UnusedAssetsScanSourceArray;
+	TArray<int32> UnusedAssetsScanResults;
 };
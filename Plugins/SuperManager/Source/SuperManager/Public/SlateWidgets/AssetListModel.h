@@ -0,0 +1,130 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Forward Declarations */
+class FAssetReferenceIndex;
+
+/** Per row state of the asset list */
+enum class EAssetListItemFlags : uint8
+{
+	None		= 0,
+	Removed		= 1 << 0
+};
+ENUM_CLASS_FLAGS(EAssetListItemFlags);
+
+/** Values of one registry tag for every row, extracted once so filters only loop over plain arrays */
+struct FAssetTagColumn
+{
+	/** Zero when the value doesn't read as a number, 2048x1024 reads as its largest side */
+	TArray<double> NumericValues;
+
+	/** Lowercase, empty when the row has no value */
+	TArray<FString> StringValues;
+
+	/** Set for the rows that have the tag, and for the ones whose value is a number */
+	TBitArray<> HasValues;
+	TBitArray<> HasNumericValues;
+
+	FORCEINLINE int32 Num() const { return NumericValues.Num(); }
+};
+
+/** Row handed to the list view, the asset itself lives in the model columns */
+struct FAssetListItem
+{
+	explicit FAssetListItem(int32 InIndex)
+		: Index(InIndex)
+	{
+
+	}
+
+	const int32 Index;
+};
+
+/**
+ * Structure of arrays table of the assets listed by the Advanced Deletion tab.
+ * Rows are never moved, so indices and items handed out stay valid, removed rows are only flagged.
+ * Must be owned by a shared pointer, items share its reference count.
+ */
+class FAssetListModel : public TSharedFromThis<FAssetListModel>
+{
+public:
+	void Reserve(int32 NumAssets);
+	int32 Add(const FAssetData& AssetData);
+
+	/** Whole gather at once, the columns grow a single time */
+	void Append(TConstArrayView<FAssetData> AssetsData);
+
+	FORCEINLINE int32 Num() const { return PackageNames.Num(); }
+
+	/** Points into the model, keeps it alive without an allocation per row */
+	TSharedPtr<FAssetListItem> GetItem(int32 Index);
+
+	FORCEINLINE FName GetPackageName(int32 Index) const { return PackageNames[Index]; }
+	FORCEINLINE FName GetPackagePath(int32 Index) const { return PackagePaths[Index]; }
+	FORCEINLINE FName GetAssetName(int32 Index) const { return AssetNames[Index]; }
+	FORCEINLINE FName GetAssetClass(int32 Index) const { return AssetClasses[Index]; }
+
+	/** INDEX_NONE until the row's size has been read */
+	FORCEINLINE int64 GetDiskSize(int32 Index) const { return DiskSizes[Index]; }
+	FORCEINLINE int32 GetReferencerCount(int32 Index) const { return ReferencerCounts[Index]; }
+	FORCEINLINE bool HasReferencerCounts() const { return bHasReferencerCounts; }
+
+	/** Typed values of a registry tag, rows added since the last call are read from the registry in one query, nothing is loaded */
+	const FAssetTagColumn& GetTagColumn(FName TagName);
+
+	/** Refreshes the referencer column of every row, one index lookup per row */
+	void UpdateReferencerCounts(const FAssetReferenceIndex& ReferenceIndex);
+
+	/** Only refreshes the rows of the given packages */
+	void UpdateReferencerCounts(const FAssetReferenceIndex& ReferenceIndex, TConstArrayView<FName> ChangedPackageNames);
+
+	/** Reads the size from the registry the first time, only rows that are shown or sorted ever are */
+	int64 ReadDiskSize(int32 Index);
+
+	FORCEINLINE bool IsRemoved(int32 Index) const { return EnumHasAnyFlags(Flags[Index], EAssetListItemFlags::Removed); }
+
+	/** Removed rows are deselected as well */
+	void MarkRemoved(int32 Index);
+
+	/** Selection, rows and bulk actions only read it, so it holds for rows that have no widget */
+	FORCEINLINE bool IsSelected(int32 Index) const { return SelectedRows[Index]; }
+	FORCEINLINE int32 GetNumSelected() const { return NumSelected; }
+	void SetSelected(int32 Index, bool bSelected);
+	void ClearSelection();
+
+	FString GetObjectPath(int32 Index) const;
+
+	/** Rebuilt from the columns, without tags, enough to delete or sync to the asset */
+	FAssetData MakeAssetData(int32 Index) const;
+
+private:
+	/** Chunked so items keep their address as rows are added */
+	TChunkedArray<FAssetListItem> Items;
+
+	TArray<FName> PackageNames;
+	TArray<FName> PackagePaths;
+	TArray<FName> AssetNames;
+	TArray<FName> AssetClasses;
+
+	/** Rows of each package, so a registry change only touches the rows it affects */
+	TMultiMap<FName, int32> RowsByPackageName;
+
+	/** Registry tags are read once per tag into a column, the rows' tag maps aren't kept */
+	TMap<FName, TUniquePtr<FAssetTagColumn>> TagColumns;
+
+	/** Size of the package file on disk, INDEX_NONE until read, zero when the registry doesn't know it */
+	TArray<int64> DiskSizes;
+
+	/** INDEX_NONE until a reference index has been applied */
+	TArray<int32> ReferencerCounts;
+	bool bHasReferencerCounts = false;
+
+	TArray<EAssetListItemFlags> Flags;
+
+	/** One bit per row, NumSelected is kept in step so nothing has to count them */
+	TBitArray<> SelectedRows;
+	int32 NumSelected = 0;
+};
@@ -0,0 +1,54 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Forward Declarations */
+class FAssetListModel;
+
+enum class EAssetTagFilterOperator : uint8
+{
+	Equal,
+	NotEqual,
+	Less,
+	LessEqual,
+	Greater,
+	GreaterEqual,
+
+	/** Substring of the value, strings only */
+	Contains
+};
+
+/** <Tag> <Operator> <Value>, compares numbers when the value is one, lowercase strings otherwise */
+struct FAssetTagPredicate
+{
+	FName TagName;
+	EAssetTagFilterOperator Operator = EAssetTagFilterOperator::Equal;
+
+	FString StringValue;
+	double NumericValue = 0.0;
+	bool bIsNumeric = false;
+};
+
+/**
+ * Filter expression over asset registry tags, e.g. "Dimensions > 2048" or "Triangles >= 100000 AND LODs < 2 OR Format == PF_B8G8R8A8".
+ * AND binds tighter than OR, values with spaces go in double quotes. Rows without the tag never match a predicate on it.
+ */
+class FAssetTagFilter
+{
+public:
+	/** Replaces the current expression, an empty one matches everything */
+	bool Parse(const FString& Expression, FString& OutError);
+
+	FORCEINLINE bool IsEmpty() const { return Clauses.Num() == 0; }
+
+	/** One bit per model row, every predicate is a single loop over its tag column */
+	void Evaluate(FAssetListModel& AssetListModel, TBitArray<>& OutMatches) const;
+
+private:
+	static void EvaluatePredicate(FAssetListModel& AssetListModel, const FAssetTagPredicate& Predicate, TBitArray<>& InOutMatches);
+
+	/** OR of AND clauses */
+	TArray<TArray<FAssetTagPredicate>> Clauses;
+};
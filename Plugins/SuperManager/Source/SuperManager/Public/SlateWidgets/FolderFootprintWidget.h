@@ -0,0 +1,45 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "Widgets/SCompoundWidget.h"
+#include "AssetAnalysis/FolderFootprint.h"
+
+class SFolderFootprintTab : public SCompoundWidget
+{
+	SLATE_BEGIN_ARGS(SFolderFootprintTab) { }
+	SLATE_ARGUMENT(FString, RootFolder)
+	SLATE_END_ARGS()
+
+public:
+	void Construct(const FArguments& InArgs);
+
+private:
+	TSharedRef<SListView<TSharedPtr<FFolderFootprintEntry>>> ConstructFolderListView();
+	TSharedRef<SListView<TSharedPtr<FFolderFootprintEntry>>> ConstructClassListView();
+	TSharedRef<ITableRow> OnGenerateRowForFootprint(TSharedPtr<FFolderFootprintEntry> EntryToDisplay, const TSharedRef<STableViewBase>& OwnerTable);
+	void OnFolderRowDoubleClicked(TSharedPtr<FFolderFootprintEntry> ClickedEntry);
+
+	TSharedRef<STextBlock> ConstructListTitle(const FString& TextContent);
+
+	TSharedRef<SButton> ConstructRefreshButton();
+	FReply OnRefreshButtonClicked();
+
+	FText GetSummaryText() const;
+
+	/** Asks the module, cached results come back straight away */
+	void RequestFootprint(bool bForceRefresh);
+	void OnFootprintReady(TSharedRef<const FFolderFootprint, ESPMode::ThreadSafe> ReadyFootprint);
+
+	/** Variables */
+	FString RootFolder;
+
+	TSharedPtr<const FFolderFootprint, ESPMode::ThreadSafe> Footprint;
+	bool bIsComputing = false;
+
+	TArray<TSharedPtr<FFolderFootprintEntry>> FolderItemsArray;
+	TArray<TSharedPtr<FFolderFootprintEntry>> ClassItemsArray;
+
+	TSharedPtr<SListView<TSharedPtr<FFolderFootprintEntry>>> ConstructedFolderListView;
+	TSharedPtr<SListView<TSharedPtr<FFolderFootprintEntry>>> ConstructedClassListView;
+};
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
+#include "AssetAnalysis/UnusedAssetsTracker.h"
 
 /** Forward Declarations */
 class FMenuBuilder;
@@ -11,6 +12,11 @@ class UEditorActorSubsystem;
 class FUICommandList;
 class ISceneOutliner;
 class ISceneOutlinerColumn;
+class FAssetReferenceIndex;
+class FUnusedAssetsScanner;
+class FAssetListModel;
+struct FAssetListItem;
+class FFolderFootprint;
 
 class FSuperManagerModule : public IModuleInterface
 {
@@ -23,10 +29,27 @@ public:
 	/** Process Data For Advanced Deletion Tab */
 	bool DeleteSingleAssetForAssetList(const FAssetData& AssetDataToDelete);
 	bool DeleteMultipleAssetsForAssetList(const TArray<FAssetData>& AssetsDataToDeleteArray);
-	void ListUnusedAssetsForAssetList(const TArray<TSharedPtr<FAssetData>>& AssetsDataToFilter, TArray<TSharedPtr<FAssetData>>& OutUnusedAssetsData);
-	void ListSameNameAssetsForAssetList(const TArray<TSharedPtr<FAssetData>>& AssetsDataToFilter, TArray<TSharedPtr<FAssetData>>& OutSameNameAssetsData);
+	void ListUnusedAssetsForAssetList(const FAssetListModel& AssetListModel, const TArray<TSharedPtr<FAssetListItem>>& AssetItemsToFilter, TArray<TSharedPtr<FAssetListItem>>& OutUnusedAssetItems);
+	TSharedRef<FUnusedAssetsScanner, ESPMode::ThreadSafe> StartUnusedAssetsScanForAssetList(const FAssetListModel& AssetListModel, const TArray<TSharedPtr<FAssetListItem>>& AssetItemsToFilter);
+
+	/** Returns false while the reference index is still being built */
+	bool ListUnreachableAssetsForAssetList(const FAssetListModel& AssetListModel, const TArray<TSharedPtr<FAssetListItem>>& AssetItemsToFilter, TArray<TSharedPtr<FAssetListItem>>& OutUnreachableAssetItems);
+
+	void ListSameNameAssetsForAssetList(const FAssetListModel& AssetListModel, const TArray<TSharedPtr<FAssetListItem>>& AssetItemsToFilter, TArray<TSharedPtr<FAssetListItem>>& OutSameNameAssetItems);
 	void SyncContentBrowserToClickedAssetForAssetList(const FString& AssetPathToSync);
 
+	/** Dry run, writes the plan to Saved/SuperManager and shows its summary */
+	void PlanDeletion(const TArray<FAssetData>& AssetsDataToDelete);
+
+	/** Process Data For Folder Footprint Tab */
+	void RequestFolderFootprint(const FString& RootPath, bool bForceRefresh, TFunction<void(TSharedRef<const FFolderFootprint, ESPMode::ThreadSafe>)> OnFootprintReady);
+	void SyncContentBrowserToFolder(const FString& FolderPathToSync);
+
+	/** Shared Reverse Reference Index, null until its background build has finished */
+	TSharedPtr<FAssetReferenceIndex, ESPMode::ThreadSafe> GetAssetReferenceIndex();
+	void InvalidateAssetReferenceIndex();
+	FORCEINLINE FUnusedAssetsTracker& GetUnusedAssetsTracker() { return UnusedAssetsTracker; }
+
 	bool CheckIsActorSelectionLocked(AActor* ActorToProcess);
 	void ProcessLockingForOutliner(AActor* ActorToProcess, bool bShouldLock);
 
@@ -37,10 +60,17 @@ private:
 	void AddContentBrowserMenuEntry(FMenuBuilder& MenuBuilder);
 	
 	void OnDeleteUnusedAssetsButtonClicked();
+	void OnDeleteUnreachableAssetsButtonClicked();
+	void OnPlanUnusedAssetsDeletionButtonClicked();
 	void OnDeleteEmptyFoldersButtonClicked();
+	void OnDeleteOrphanedExternalPackagesButtonClicked();
 	void OnAdvancedDeletionButtonClicked();
+	void OnFolderFootprintButtonClicked();
 
-	void FixUpRedirectors();
+	void FixUpRedirectors(const TArray<FString>& FolderPaths);
+
+	/** Registry proven deletions, unloaded packages are deleted from disk without the editor's per asset checks */
+	int32 DeleteUnreferencedAssets(const TArray<FAssetData>& AssetsDataToDelete);
 
 	TArray<FString> FoldersPathSelectedArray;
 
@@ -49,10 +79,24 @@ private:
 	void UnregisterAdvancedDeletionTab();
 	TSharedRef<SDockTab> OnSpawnAdvancedDeletionTab(const FSpawnTabArgs& SpawnTabArgs);
 	void OnAdvancedDeletionTabClosed(TSharedRef<SDockTab> TabToClose);
-	TArray<TSharedPtr<FAssetData>> GetAllAssetsDataUnderSelectedFolder();
+	TSharedRef<FAssetListModel> GetAssetListModelForSelectedFolders();
 
 	TSharedPtr<SDockTab> AdvancedDeletionTab;
 
+	/** Folder Footprint Tab */
+	void RegisterFolderFootprintTab();
+	void UnregisterFolderFootprintTab();
+	TSharedRef<SDockTab> OnSpawnFolderFootprintTab(const FSpawnTabArgs& SpawnTabArgs);
+
+	TSharedPtr<SDockTab> FolderFootprintTab;
+	FString FolderFootprintRootPath;
+
+	/** Footprints already measured, by root folder, kept until refreshed */
+	TMap<FString, TSharedPtr<const FFolderFootprint, ESPMode::ThreadSafe>> FolderFootprintCache;
+
+	/** Keeps the reference index and the unused packages in sync with the Asset Registry */
+	FUnusedAssetsTracker UnusedAssetsTracker;
+
 	/** Level Editor Menu Extension */
 	void InitLevelEditorMenuExtension();
 	TSharedRef<FExtender> CustomLevelEditorMenuExtender(const TSharedRef<FUICommandList> UICommandList, const TArray<AActor*> SelectedActorsArray);
@@ -47,7 +47,12 @@ public class SuperManager : ModuleRules
                 "AssetTools",
                 "ContentBrowser",
 				"InputCore",
-                "Projects"
+                "Projects",
+                "DeveloperSettings",
+                "DeveloperToolSettings",
+                "EngineSettings",
+                "Json",
+                "SourceControl"
             }
 		);
 		